@@ -0,0 +1,160 @@
+// error64 microbenchmarks: strerror64(), strerror64ex(), glossary() and ERROR64_GET_*() decoding,
+// over hot-set and random-set code distributions, single-threaded and under N-thread errno64 traffic.
+// Output is CSV (one row per case) so runs can be diffed to catch regressions.
+// Usage: cc -O2 bench.c -lpthread && ./a.out [threads=4] > bench.csv
+// - rlyeh, public domain.
+
+#define ERROR64_DEFINE_IMPLEMENTATION
+#define ERRNO64_DEFINE_IMPLEMENTATION
+#include "error64.h"
+#include <stdlib.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Previous implementation, kept as baseline (formats into a scratch buffer to avoid the old src/dst overlap).
+// Messages are well under 128 bytes, so a 128-byte scratch leaves room for the extended suffix in buf256
+static const char *strerror64ex_sprintf( char buf256[256], int64_t error64 ) {
+    char msg[128];
+    if( error64 >= 0 ) {
+        snprintf( buf256, 256, "No error ; ERR_%p", (void *)error64 );
+    } else {
+        snprintf( buf256, 256, "%s ; ERR_%p error=%d,api=%d,rev=%d,line=%d,neg=%d,attr=%d,noun=%d",
+            (strerror64_n(msg, sizeof(msg), error64), msg),
+            (void *)error64,
+            ERROR64_GET_E(error64),
+            ERROR64_GET_V(error64),
+            ERROR64_GET_R(error64),
+            ERROR64_GET_L(error64),
+            ERROR64_GET_N(error64),
+            ERROR64_GET_A(error64),
+            ERROR64_GET_U(error64)
+        );
+    }
+    return buf256;
+}
+
+// Wall-clock nanoseconds (threaded cases must not sum per-thread cpu time, as clock() does)
+static double bench_now( void ) {
+#ifdef _WIN32
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency( &f ); QueryPerformanceCounter( &t );
+    return (double)t.QuadPart * 1e9 / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+enum { N = 4 * 1000 * 1000, HOT = 8, RANDOM = 65536 };
+static int64_t codes[RANDOM];
+
+// sets: hot = a few codes raised over and over (cache-resident); random = 64K distinct codes (lines, nouns, attributes)
+typedef struct bench_set { const char *name; unsigned mask; } bench_set;
+static const bench_set sets[] = { { "hot", HOT - 1 }, { "random", RANDOM - 1 } };
+
+// Benchmarked operation: handles one code, returns bytes produced (bytes/op column)
+typedef size_t (*bench_op)( int64_t ec, char buf256[256] );
+
+static size_t op_strerror64( int64_t ec, char buf256[256] )         { return strlen( strerror64( buf256, ec ) ); }
+static size_t op_strerror64_n( int64_t ec, char buf256[256] )       { return strerror64_n( buf256, 256, ec ); }
+static size_t op_strerror64ex( int64_t ec, char buf256[256] )       { return strlen( strerror64ex( buf256, ec ) ); }
+static size_t op_strerror64ex_n( int64_t ec, char buf256[256] )     { return strerror64ex_n( buf256, 256, ec ); }
+static size_t op_strerror64ex_sprintf( int64_t ec, char buf256[256] ) { return strlen( strerror64ex_sprintf( buf256, ec ) ); }
+static size_t op_glossary( int64_t ec, char buf256[256] )           { return (void)buf256, strlen( glossary( ERROR64_GET_U(ec) ) ); }
+static volatile int32_t bench_sink; // decoded fields go here, so they are not optimized away
+static size_t op_get_fields( int64_t ec, char buf256[256] ) {
+    (void)buf256;
+    bench_sink = ERROR64_GET_E(ec) + ERROR64_GET_V(ec) + ERROR64_GET_R(ec) + ERROR64_GET_L(ec) +
+        ERROR64_GET_N(ec) + ERROR64_GET_A(ec) + ERROR64_GET_U(ec);
+    return 0;
+}
+static size_t op_errno64( int64_t ec, char buf256[256] ) {
+    // raise into errno64, then read it back as callers do
+    errno64 = ec;
+    return strerror64_n( buf256, 256, errno64 );
+}
+
+static const struct { const char *name; bench_op op; } ops[] = {
+    { "strerror64",           op_strerror64 },
+    { "strerror64_n",         op_strerror64_n },
+    { "strerror64ex",         op_strerror64ex },
+    { "strerror64ex_n",       op_strerror64ex_n },
+    { "strerror64ex_sprintf", op_strerror64ex_sprintf },
+    { "glossary",             op_glossary },
+    { "ERROR64_GET_*",        op_get_fields },
+    { "errno64+strerror64_n", op_errno64 },
+};
+
+typedef struct bench_job { bench_op op; unsigned mask, seed; size_t bytes; } bench_job;
+
+static void bench_run( bench_job *job ) {
+    char buf256[256];
+    size_t bytes = 0;
+    unsigned i, at = job->seed;
+    for( i = 0; i < N; ++i, at = at * 1664525u + 1013904223u ) {
+        bytes += job->op( codes[(at >> 8) & job->mask], buf256 );
+    }
+    job->bytes = bytes;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI bench_thread( LPVOID job ) { bench_run( (bench_job *)job ); return 0; }
+#else
+static void *bench_thread( void *job ) { bench_run( (bench_job *)job ); return 0; }
+#endif
+
+// Runs one case on `threads` threads (1: calling thread). Prints a CSV row; ns/op is wall time per op of one thread
+static void bench_case( const char *name, bench_op op, const bench_set *set, int threads ) {
+    bench_job jobs[64];
+    size_t bytes = 0;
+    double t0;
+    int t;
+    for( t = 0; t < threads; ++t ) jobs[t].op = op, jobs[t].mask = set->mask, jobs[t].seed = 12345u + (unsigned)t, jobs[t].bytes = 0;
+    t0 = bench_now();
+    if( threads == 1 ) {
+        bench_run( &jobs[0] );
+    } else {
+#ifdef _WIN32
+        HANDLE th[64];
+        for( t = 0; t < threads; ++t ) th[t] = CreateThread( 0, 0, bench_thread, &jobs[t], 0, 0 );
+        WaitForMultipleObjects( (DWORD)threads, th, TRUE, INFINITE );
+        for( t = 0; t < threads; ++t ) CloseHandle( th[t] );
+#else
+        pthread_t th[64];
+        for( t = 0; t < threads; ++t ) pthread_create( &th[t], 0, bench_thread, &jobs[t] );
+        for( t = 0; t < threads; ++t ) pthread_join( th[t], 0 );
+#endif
+    }
+    t0 = bench_now() - t0;
+    for( t = 0; t < threads; ++t ) bytes += jobs[t].bytes;
+    printf( "%s,%s,%d,%.2f,%.2f\n", name, set->name, threads, t0 / N, (double)bytes / ((double)N * threads) );
+    fflush( stdout );
+}
+
+int main( int argc, char **argv ) {
+    int threads = argc > 1 ? atoi( argv[1] ) : 4, i, s;
+    unsigned seed = 1;
+
+    if( threads < 1 ) threads = 1;
+    if( threads > 64 ) threads = 64;
+
+    for( i = 0; i < RANDOM; ++i ) {
+        seed = seed * 1103515245u + 12345u;
+        codes[i] = ERR_ERROR | ((int64_t)(seed % 65535) << ERR_BIT_L) |
+            ((seed >> 16) & 1 ? ERR_NOT : 0) | ((int64_t)((seed >> 8) % 152) << ERR_BIT_A) | (seed % 200);
+    }
+
+    puts( "case,set,threads,ns_per_op,bytes_per_op" );
+    for( i = 0; i < (int)(sizeof(ops) / sizeof(ops[0])); ++i ) {
+        for( s = 0; s < 2; ++s ) {
+            bench_case( ops[i].name, ops[i].op, &sets[s], 1 );
+            if( threads > 1 ) bench_case( ops[i].name, ops[i].op, &sets[s], threads );
+        }
+    }
+    return 0;
+}
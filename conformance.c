@@ -0,0 +1,600 @@
+// Differential conformance harness: strerror64(), strerror64_n(), strerror64ex_n(), glossary() and strtoerror64() against
+// the original switch/strcat implementation, over all 2^24 descriptors (N+A+U fields), with random locators (V+R+L fields) on top.
+// Runs on N threads, prints mismatches, intended divergences and throughput (build with -DERROR64_PRECOMPUTED_TABLE to check the table too).
+// Usage: cc -O2 conformance.c -lpthread && ./a.out [threads=online cores] [locators per descriptor=1]
+// libFuzzer: clang -g -O1 -fsanitize=fuzzer,address -DERROR64_FUZZ conformance.c (input: 8 code bytes, then parser text)
+// - rlyeh, public domain.
+
+#define ERROR64_DEFINE_IMPLEMENTATION
+#define ERRNO64_DEFINE_IMPLEMENTATION
+#include "error64.h"
+#include <stdlib.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Reference implementation: strerror64(), strerror64ex() and glossary() as first released, verbatim but renamed and static.
+// Only change: strerror64ex() formats its message into msg (the original passed buf256 as both target and %s argument).
+static const char *base_glossary( int enumeration );
+#if defined(__GNUC__) && __GNUC__ >= 7 && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-overflow" // sprintf() of a 256-byte message into 256 bytes: the original's
+#endif
+
+// Print error to a [256] char buffer
+static const char *base_strerror64( char buf256[256], int64_t errno64 ) {
+    if( errno64 >= 0 ) return (buf256[0] = '\0', buf256);
+    const char *neg = "", *adj = "";
+    char noun[256-48];
+    strcpy( noun, base_glossary(errno64 & 0x7fff) );
+    if( errno64 & ( 1LL << ERR_BIT_N ) ) {
+        neg = "NOT";
+    }
+    switch( errno64 & ( 0xffLL << ERR_BIT_A ) ) {
+        default:
+        break; case ERR_A: adj = "A";
+        break; case ERR_ACK: adj = "ACK";
+        break; case ERR_ACTIVE: adj = "ACTIVE";
+        break; case ERR_ALIGNED: adj = "ALIGNED";
+        break; case ERR_ALLOWED: adj = "ALLOWED";
+        break; case ERR_ASSIGNED: adj = "ASSIGNED";
+        break; case ERR_ATTACHED: adj = "ATTACHED";
+        break; case ERR_ATTEMPTED: adj = "ATTEMPTED";
+        break; case ERR_AUTHORIZED: adj = "AUTHORIZED";
+        break; case ERR_AVAILABLE: adj = "AVAILABLE";
+        break; case ERR_BAD: adj = "BAD";
+        break; case ERR_BLOCKED: adj = "BLOCKED";
+        break; case ERR_BROKEN: adj = "BROKEN";
+        break; case ERR_BUILT: adj = "BUILT";
+        break; case ERR_BUSY: adj = "BUSY";
+        break; case ERR_CLOSED: adj = "CLOSED";
+        break; case ERR_COMPILED: adj = "COMPILED";
+        break; case ERR_COMPLETE: adj = "COMPLETE";
+        break; case ERR_CONFLICTED: adj = "CONFLICTED";
+        break; case ERR_CONNECTED: adj = "CONNECTED";
+        break; case ERR_CONSTRUCTED: adj = "CONSTRUCTED";
+        break; case ERR_CREATED: adj = "CREATED";
+        break; case ERR_DEFINED: adj = "DEFINED";
+        break; case ERR_DENIED: adj = "DENIED";
+        break; case ERR_DESTRUCTED: adj = "DESTRUCTED";
+        break; case ERR_DETACHED: adj = "DETACHED";
+        break; case ERR_DETECTED: adj = "DETECTED";
+        break; case ERR_DOWN: adj = "DOWN";
+        break; case ERR_DOWNLOADED: adj = "DOWNLOADED";
+        break; case ERR_EMPTY: adj = "EMPTY";
+        break; case ERR_ENHANCED: adj = "ENHANCED";
+        break; case ERR_ENOUGH: adj = "ENOUGH";
+        break; case ERR_EXCEEDED: adj = "EXCEEDED";
+        break; case ERR_EXCHANGED: adj = "EXCHANGED";
+        break; case ERR_EXECUTABLE: adj = "EXECUTABLE";
+        break; case ERR_EXISTS: adj = "EXISTS";
+        break; case ERR_EXPIRED: adj = "EXPIRED";
+        break; case ERR_EXTENDED: adj = "EXTENDED";
+        break; case ERR_FAILED: adj = "FAILED";
+        break; case ERR_FALSE: adj = "FALSE";
+        break; case ERR_FATAL: adj = "FATAL";
+        break; case ERR_FORBIDDEN: adj = "FORBIDDEN";
+        break; case ERR_FORMATTED: adj = "FORMATTED";
+        break; case ERR_FOUND: adj = "FOUND";
+        break; case ERR_FULL: adj = "FULL";
+        break; case ERR_GONE: adj = "GONE";
+        break; case ERR_GOOD: adj = "GOOD";
+        break; case ERR_HALTED: adj = "HALTED";
+        break; case ERR_HOLD: adj = "HOLD";
+        break; case ERR_IDLE: adj = "IDLE";
+        break; case ERR_ILLEGAL: adj = "ILLEGAL";
+        break; case ERR_IMPLEMENTED: adj = "IMPLEMENTED";
+        break; case ERR_IN_PROGRESS: adj = "IN PROGRESS";
+        break; case ERR_IN_USE: adj = "IN USE";
+        break; case ERR_INITIALIZED: adj = "INITIALIZED";
+        break; case ERR_INSTALLED: adj = "INSTALLED";
+        break; case ERR_INTERRUPTED: adj = "INTERRUPTED";
+        break; case ERR_KNOWN: adj = "KNOWN";
+        break; case ERR_LINKED: adj = "LINKED";
+        break; case ERR_LOADED: adj = "LOADED";
+        break; case ERR_LOCAL: adj = "LOCAL";
+        break; case ERR_LOCKED: adj = "LOCKED";
+        break; case ERR_LOOPED: adj = "LOOPED";
+        break; case ERR_LOST: adj = "LOST";
+        break; case ERR_MISSING: adj = "MISSING";
+        break; case ERR_MOUNTED: adj = "MOUNTED";
+        break; case ERR_NEEDED: adj = "NEEDED";
+        break; case ERR_NO: adj = "NO";
+        break; case ERR_NO_SUCH: adj = "NO SUCH";
+        break; case ERR_OFF: adj = "OFF";
+        break; case ERR_ON: adj = "ON";
+        break; case ERR_ONLINE: adj = "ONLINE";
+        break; case ERR_OPEN: adj = "OPEN";
+        break; case ERR_ORDERED: adj = "ORDERED";
+        break; case ERR_OUT_OF: adj = "OUT OF";
+        break; case ERR_OUT_OF_RANGE: adj = "OUT OF RANGE";
+        break; case ERR_OVERFLOW: adj = "OVERFLOW";
+        break; case ERR_PADDED: adj = "PADDED";
+        break; case ERR_PERMITTED: adj = "PERMITTED";
+        break; case ERR_PROCESSABLE: adj = "PROCESSABLE";
+        break; case ERR_PROVIDED: adj = "PROVIDED";
+        break; case ERR_REACHABLE: adj = "REACHABLE";
+        break; case ERR_READABLE: adj = "READABLE";
+        break; case ERR_RECEIVED: adj = "RECEIVED";
+        break; case ERR_REFUSED: adj = "REFUSED";
+        break; case ERR_REGISTERED: adj = "REGISTERED";
+        break; case ERR_REJECTED: adj = "REJECTED";
+        break; case ERR_RELEASED: adj = "RELEASED";
+        break; case ERR_REMOTE: adj = "REMOTE";
+        break; case ERR_RENDERABLE: adj = "RENDERABLE";
+        break; case ERR_RESERVED: adj = "RESERVED";
+        break; case ERR_RESET: adj = "RESET";
+        break; case ERR_RESPONDING: adj = "RESPONDING";
+        break; case ERR_RETRIED: adj = "RETRIED";
+        break; case ERR_RIGHT: adj = "RIGHT";
+        break; case ERR_RUNNING: adj = "RUNNING";
+        break; case ERR_SENT: adj = "SENT";
+        break; case ERR_SPECIFIED: adj = "SPECIFIED";
+        break; case ERR_STALLED: adj = "STALLED";
+        break; case ERR_STOPPED: adj = "STOPPED";
+        break; case ERR_SUCEEDED: adj = "SUCEEDED";
+        break; case ERR_SUITABLE: adj = "SUITABLE";
+        break; case ERR_SUPPORTED: adj = "SUPPORTED";
+        break; case ERR_SYNCHRONIZED: adj = "SYNCHRONIZED";
+        break; case ERR_TERMINATED: adj = "TERMINATED";
+        break; case ERR_THROWN: adj = "THROWN";
+        break; case ERR_TIMED_OUT: adj = "TIMED OUT";
+        break; case ERR_TOO_COMPLEX: adj = "TOO COMPLEX";
+        break; case ERR_TOO_FEW: adj = "TOO FEW";
+        break; case ERR_TOO_LARGE: adj = "TOO LARGE";
+        break; case ERR_TOO_LONG: adj = "TOO LONG";
+        break; case ERR_TOO_MANY: adj = "TOO MANY";
+        break; case ERR_TOO_MUCH: adj = "TOO MUCH";
+        break; case ERR_TOO_SIMPLE: adj = "TOO SIMPLE";
+        break; case ERR_TOO_SMALL: adj = "TOO SMALL";
+        break; case ERR_TRIGGERED: adj = "TRIGGERED";
+        break; case ERR_TRUE: adj = "TRUE";
+        break; case ERR_UNIQUE: adj = "UNIQUE";
+        break; case ERR_UP: adj = "UP";
+        break; case ERR_UPDATED: adj = "UPDATED";
+        break; case ERR_UPGRADED: adj = "UPGRADED";
+        break; case ERR_UPLOADED: adj = "UPLOADED";
+        break; case ERR_USED: adj = "USED";
+        break; case ERR_VALID: adj = "VALID";
+        break; case ERR_WORKING: adj = "WORKING";
+        break; case ERR_WRITABLE: adj = "WRITABLE";
+        break; case ERR_WRONG: adj = "WRONG";
+    };
+    const char *common[] = { noun, neg, adj }, *special[] = { neg, adj, noun }, **use = common;
+    int64_t type = errno64 & (0x1ffLL << ERR_BIT_A);
+    if( (type == ERR_A)  || (type == ERR_NOT_A) ||
+        (type == ERR_NO) || (type == ERR_NO_SUCH) ||
+        (type == ERR_ENOUGH) || (type == ERR_NOT_ENOUGH) ) {
+        use = special;
+    }
+    strcpy( buf256, (use)[0] );
+    strcat( buf256, (use)[0][0] ? " " : "" );
+    strcat( buf256, (use)[1] );
+    strcat( buf256, (use)[1][0] ? " " : "" );
+    strcat( buf256, (use)[2] );
+    return (buf256[255] = '\0', buf256);
+}
+
+// Print error to a [256] char buffer (extended info)
+static const char *base_strerror64ex( char buf256[256], int64_t error64 ) {
+    char msg[256];
+    if( error64 >= 0 ) {
+        sprintf( buf256, "No error ; ERR_%p", (void *)error64 );
+    } else {
+        sprintf( buf256, "%s ; ERR_%p error=%d,api=%d,rev=%d,line=%d,neg=%d,attr=%d,noun=%d",
+            base_strerror64(msg, error64),
+            (void *)error64,
+            ERROR64_GET_E(error64),
+            ERROR64_GET_V(error64),
+            ERROR64_GET_R(error64),
+            ERROR64_GET_L(error64),
+            ERROR64_GET_N(error64),
+            ERROR64_GET_A(error64),
+            ERROR64_GET_U(error64)
+        );
+    }
+    return buf256;
+}
+
+// Function that resolve the glossary enums (nouns) above
+static const char *base_glossary( int enumeration ) {
+    switch( enumeration ) {
+        case NN_BLANK: return "";
+        default:  return "??";
+
+        case NN_ACCESS: return "ACCESS";
+        case NN_ACCOUNT: return "ACCOUNT";
+        case NN_ADDRESS: return "ADDRESS";
+        case NN_ADMINISTRATOR: return "ADMINISTRATOR";
+        case NN_API: return "API";
+        case NN_APPLICATION: return "APPLICATION";
+        case NN_ARCHIVE: return "ARCHIVE";
+        case NN_ARGUMENT: return "ARGUMENT";
+        case NN_ASSET: return "ASSET";
+        case NN_AUDIO: return "AUDIO";
+        case NN_AUTHENTICATION: return "AUTHENTICATION";
+        case NN_BINARY: return "BINARY";
+        case NN_BIRTHDATE: return "BIRTHDATE";
+        case NN_BLOB: return "BLOB";
+        case NN_BOX: return "BOX";
+        case NN_BROADCAST: return "BROADCAST";
+        case NN_CAPSULE: return "CAPSULE";
+        case NN_CHECKBOX: return "CHECKBOX";
+        case NN_CINEMATIC: return "CINEMATIC";
+        case NN_CIRCLE: return "CIRCLE";
+        case NN_CLASS: return "CLASS";
+        case NN_CLIENT: return "CLIENT";
+        case NN_CLOUD: return "CLOUD";
+        case NN_CODE: return "CODE";
+        case NN_COMBO: return "COMBO";
+        case NN_COMMIT: return "COMMIT";
+        case NN_COMPILATION: return "COMPILATION";
+        case NN_COMPILER: return "COMPILER";
+        case NN_COMPRESSION: return "COMPRESSION";
+        case NN_CONSOLE: return "CONSOLE";
+        case NN_CONTROLLER: return "CONTROLLER";
+        case NN_COUNTRY: return "COUNTRY";
+        case NN_CVS: return "CVS";
+        case NN_CYPHERING: return "CYPHERING";
+        case NN_DAEMON: return "DAEMON";
+        case NN_DATA: return "DATA";
+        case NN_DEPENDENCY: return "DEPENDENCY";
+        case NN_DESCRIPTOR: return "DESCRIPTOR";
+        case NN_DEVICE: return "DEVICE";
+        case NN_DIAGRAM: return "DIAGRAM";
+        case NN_DIRECTORY: return "DIRECTORY";
+        case NN_DISK: return "DISK";
+        case NN_DLL: return "DLL";
+        case NN_DOMAIN: return "DOMAIN";
+        case NN_DOWNLOAD: return "DOWNLOAD";
+        case NN_DRIVER: return "DRIVER";
+        case NN_EDITOR: return "EDITOR";
+        case NN_ENDPOINT: return "ENDPOINT";
+        case NN_ENGINE: return "ENGINE";
+        case NN_EVALUATION: return "EVALUATION";
+        case NN_EVALUATOR: return "EVALUATOR";
+        case NN_EVENT: return "EVENT";
+        case NN_EXCEPTION: return "EXCEPTION";
+        case NN_EXCHANGE: return "EXCHANGE";
+        case NN_EXPECTATION: return "EXPECTATION";
+        case NN_FETCH: return "FETCH";
+        case NN_FILE: return "FILE";
+        case NN_FLOAT: return "FLOAT";
+        case NN_FLOW: return "FLOW";
+        case NN_FOLDER: return "FOLDER";
+        case NN_FONT: return "FONT";
+        case NN_FORMAT: return "FORMAT";
+        case NN_FUNCTION: return "FUNCTION";
+        case NN_GAME: return "GAME";
+        case NN_GAMEPAD: return "GAMEPAD";
+        case NN_GATEWAY: return "GATEWAY";
+        case NN_GEOMETRY: return "GEOMETRY";
+        case NN_GIZMO: return "GIZMO";
+        case NN_GRAPH: return "GRAPH";
+        case NN_GRAPHICS: return "GRAPHICS";
+        case NN_GROUP: return "GROUP";
+        case NN_HANDLE: return "HANDLE";
+        case NN_HARDWARE: return "HARDWARE";
+        case NN_HEADER: return "HEADER";
+        case NN_HID: return "HID";
+        case NN_HMD: return "HMD";
+        case NN_HOST: return "HOST";
+        case NN_IDENTIFIER: return "IDENTIFIER";
+        case NN_INDEX: return "INDEX";
+        case NN_INPUT: return "INPUT";
+        case NN_INTEGER: return "INTEGER";
+        case NN_INTERFACE: return "INTERFACE";
+        case NN_INTERVAL: return "INTERVAL";
+        case NN_IO: return "IO";
+        case NN_JOYSTICK: return "JOYSTICK";
+        case NN_KEYBOARD: return "KEYBOARD";
+        case NN_LENGTH: return "LENGTH";
+        case NN_LEVEL: return "LEVEL";
+        case NN_LIBRARY: return "LIBRARY";
+        case NN_LIMIT: return "LIMIT";
+        case NN_LINK: return "LINK";
+        case NN_LINKAGE: return "LINKAGE";
+        case NN_LINKER: return "LINKER";
+        case NN_LOCATION: return "LOCATION";
+        case NN_LOGIN: return "LOGIN";
+        case NN_LOOP: return "LOOP";
+        case NN_MACHINE: return "MACHINE";
+        case NN_MEDIA: return "MEDIA";
+        case NN_MEMORY: return "MEMORY";
+        case NN_MESH: return "MESH";
+        case NN_MESSAGE: return "MESSAGE";
+        case NN_METHOD: return "METHOD";
+        case NN_MODEL: return "MODEL";
+        case NN_MODULE: return "MODULE";
+        case NN_MONITOR: return "MONITOR";
+        case NN_MOUSE: return "MOUSE";
+        case NN_NETWORK: return "NETWORK";
+        case NN_NICKNAME: return "NICKNAME";
+        case NN_NODE: return "NODE";
+        case NN_NOTHING: return "NOTHING";
+        case NN_NUMBER: return "NUMBER";
+        case NN_OBJECT: return "OBJECT";
+        case NN_OPERATION: return "OPERATION";
+        case NN_OPERATOR: return "OPERATOR";
+        case NN_ORIENTATION: return "ORIENTATION";
+        case NN_PACKAGE: return "PACKAGE";
+        case NN_PASSWORD: return "PASSWORD";
+        case NN_PATH: return "PATH";
+        case NN_PATHFILE: return "PATHFILE";
+        case NN_PAYMENT: return "PAYMENT";
+        case NN_PAYWALL: return "PAYWALL";
+        case NN_PEER: return "PEER";
+        case NN_PERMISSION: return "PERMISSION";
+        case NN_PHYSICS: return "PHYSICS";
+        case NN_PLATFORM: return "PLATFORM";
+        case NN_PLUGIN: return "PLUGIN";
+        case NN_POSITION: return "POSITION";
+        case NN_POSTCONDITION: return "POSTCONDITION";
+        case NN_PRECONDITION: return "PRECONDITION";
+        case NN_PROFILER: return "PROFILER";
+        case NN_PROTOCOL: return "PROTOCOL";
+        case NN_PROXY: return "PROXY";
+        case NN_QUERY: return "QUERY";
+        case NN_RANGE: return "RANGE";
+        case NN_RATIO: return "RATIO";
+        case NN_RECORD: return "RECORD";
+        case NN_RENDERER: return "RENDERER";
+        case NN_REPOSITORY: return "REPOSITORY";
+        case NN_REQUEST: return "REQUEST";
+        case NN_RESOURCE: return "RESOURCE";
+        case NN_REVISION: return "REVISION";
+        case NN_ROTATION: return "ROTATION";
+        case NN_ROUTE: return "ROUTE";
+        case NN_RUNTIME: return "RUNTIME";
+        case NN_SCALE: return "SCALE";
+        case NN_SCREEN: return "SCREEN";
+        case NN_SCRIPT: return "SCRIPT";
+        case NN_SEARCH: return "SEARCH";
+        case NN_SEQUENCE: return "SEQUENCE";
+        case NN_SERIALIZATION: return "SERIALIZATION";
+        case NN_SERVER: return "SERVER";
+        case NN_SERVICE: return "SERVICE";
+        case NN_SHADER: return "SHADER";
+        case NN_SHAPE: return "SHAPE";
+        case NN_SIZE: return "SIZE";
+        case NN_SLIDER: return "SLIDER";
+        case NN_SOFTWARE: return "SOFTWARE";
+        case NN_SOURCE: return "SOURCE";
+        case NN_SPACE: return "SPACE";
+        case NN_SPHERE: return "SPHERE";
+        case NN_SQUARE: return "SQUARE";
+        case NN_STACK: return "STACK";
+        case NN_STACKTRACE: return "STACKTRACE";
+        case NN_STAGE: return "STAGE";
+        case NN_STARTPOINT: return "STARTPOINT";
+        case NN_STREAM: return "STREAM";
+        case NN_STREAMING: return "STREAMING";
+        case NN_STRING: return "STRING";
+        case NN_STRUCT: return "STRUCT";
+        case NN_SUBSYSTEM: return "SUBSYSTEM";
+        case NN_SYMBOL: return "SYMBOL";
+        case NN_SYSTEM: return "SYSTEM";
+        case NN_TEXT: return "TEXT";
+        case NN_TIME: return "TIME";
+        case NN_TOUCH: return "TOUCH";
+        case NN_TRANSFORM: return "TRANSFORM";
+        case NN_TRANSLATION: return "TRANSLATION";
+        case NN_TRANSPORT: return "TRANSPORT";
+        case NN_TRIGGER: return "TRIGGER";
+        case NN_TRUETYPE: return "TRUETYPE";
+        case NN_TYPE: return "TYPE";
+        case NN_UPGRADE: return "UPGRADE";
+        case NN_UPLOAD: return "UPLOAD";
+        case NN_USER: return "USER";
+        case NN_USERNAME: return "USERNAME";
+        case NN_VALUE: return "VALUE";
+        case NN_VARIANT: return "VARIANT";
+        case NN_VERSION: return "VERSION";
+        case NN_VISUALIZER: return "VISUALIZER";
+        case NN_WEBPAGE: return "WEBPAGE";
+        case NN_WEBSITE: return "WEBSITE";
+        case NN_WEBVIEW: return "WEBVIEW";
+        case NN_WIDGET: return "WIDGET";
+        case NN_WINDOW: return "WINDOW";
+        case NN_ZIPCODE: return "ZIPCODE";
+    }
+}
+#if defined(__GNUC__) && __GNUC__ >= 7 && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// Intended divergences from the reference, each counted on its own:
+// - X_SPACE: fragments are joined by single spaces and empty ones skipped; the reference left a trailing space ("FILE ", "NOT ")
+// - X_ATTR:  attributes the reference defined but left out of its switch are named (table-driven rewrite)
+// - X_HEX:   codes print as ERR_%016llX, not ERR_%p ("0x8000...", "(nil)")
+enum { X_SPACE, X_ATTR, X_HEX, X_COUNT };
+static const char *const x_names[X_COUNT] = { "trailing spaces dropped", "attributes added to the switch", "%p locators as %016llX" };
+
+static const char *const x_attrs[256] = {
+    [17] = "COLLIDED", [26] = "DEPARTED", [30] = "DISABLED", [34] = "ENABLED", [53] = "HIDDEN", [61] = "INSERTED",
+    [64] = "JOINED", [72] = "MERGED", [87] = "PARTED", [89] = "POPPED", [90] = "PRELOADED", [93] = "PUSHED",
+    [102] = "REMOVED", [111] = "SHARED", [112] = "SORTED", [114] = "SPLITTED", [134] = "UNBLOCKED", [135] = "UNDERFLOW",
+    [136] = "UNINITIALIZED", [137] = "UNINSTALLED", [139] = "UNLOADED", [140] = "UNLOCKED", [141] = "UNSORTED", [148] = "VISIBLE",
+};
+
+// Reference message with the divergences above applied. None of them is a special-order attribute, so added names go last
+static const char *expect_strerror64( char buf256[256], int64_t ec, uint64_t x[X_COUNT] ) {
+    const char *added = ec < 0 ? x_attrs[ (ec >> ERR_BIT_A) & 0xff ] : 0;
+    size_t len = strlen( base_strerror64( buf256, ec ) );
+    if( len && buf256[len - 1] == ' ' ) buf256[--len] = '\0', ++x[X_SPACE];
+    if( added ) strcat( buf256, len ? " " : "" ), strcat( buf256, added ), ++x[X_ATTR];
+    return buf256;
+}
+
+// Reference extended message: expected message, then the reference's fields after its %p, which must denote ec.
+// Message divergences are counted by expect_strerror64() only
+static const char *expect_strerror64ex( char buf256[256], int64_t ec, uint64_t x[X_COUNT] ) {
+    char base[256], msg[256], *at, *end;
+    uint64_t counted[X_COUNT];
+    unsigned long long p;
+    base_strerror64ex( base, ec );
+    if( (at = strstr( base, " ; ERR_" )) == 0 ) return strcpy( buf256, base );
+    at += 7;
+    p = strncmp( at, "(nil)", 5 ) ? strtoull( at, &end, 16 ) : (end = at + 5, 0);
+    if( (int64_t)p != ec ) return strcpy( buf256, base ); // reported as a mismatch
+    ++x[X_HEX];
+    snprintf( buf256, 256, "%s ; ERR_%016llX%s", ec < 0 ? expect_strerror64( msg, ec, counted ) : "No error", (unsigned long long)ec, end );
+    return buf256;
+}
+
+// Checks one code against the reference. Returns a short name of the first failing check, or NULL
+static const char *check( int64_t ec, char expected[256], char got[256], uint64_t x[X_COUNT] ) {
+    char noun[256], attr[256];
+    size_t n;
+    int u = (int)(ec & 0x7fff), a = (int)((ec >> ERR_BIT_A) & 0xff);
+    expect_strerror64( expected, ec, x );
+    n = strerror64_n( got, 256, ec );
+    if( strcmp( expected, got ) || n != strlen( got ) ) return "strerror64_n";
+    if( strcmp( expected, strerror64( got, ec ) ) ) return "strerror64";
+    if( strcmp( base_glossary( u ), glossary( u ) ) ) return (strcpy( expected, base_glossary( u ) ), strcpy( got, glossary( u ) ), "glossary");
+    // short messages of known nouns and attributes parse back into E+N+A+U (others are ambiguous: "??", blanks, "")
+    strcpy( noun, base_glossary( u ) );
+    base_strerror64( attr, ERR_ERROR | ((int64_t)a << ERR_BIT_A) );
+    if( ec < 0 && expected[0] && (!u || strcmp( noun, "??" )) && (!a || attr[0] || x_attrs[a]) &&
+        strtoerror64( expected, strlen( expected ) ) != (ec & (ERR_ERROR | 0xffffff)) ) return "strtoerror64";
+    expect_strerror64ex( expected, ec, x );
+    n = strerror64ex_n( got, 256, ec );
+    if( strcmp( expected, got ) || n != strlen( got ) ) return "strerror64ex_n";
+    if( strtoerror64( got, n ) != ec ) return "strtoerror64(ex)";
+    return 0;
+}
+
+#ifdef ERROR64_FUZZ
+int LLVMFuzzerTestOneInput( const uint8_t *data, size_t size ) {
+    char expected[256], got[256], text[512];
+    uint64_t x[X_COUNT];
+    int64_t ec;
+    const char *failed;
+    if( size < 8 ) return 0;
+    memcpy( &ec, data, 8 );
+    if( (failed = check( ec, expected, got, x )) != 0 ) {
+        fprintf( stderr, "%s mismatch on ERR_%016llX\nexpected: %s\n     got: %s\n", failed, (unsigned long long)ec, expected, got );
+        abort();
+    }
+    // the parser gets the rest as text: any code it returns must print
+    size = size - 8 < sizeof(text) ? size - 8 : sizeof(text);
+    memcpy( text, data + 8, size );
+    strerror64ex_n( got, 256, strtoerror64( text, size ) );
+    return 0;
+}
+#else
+
+enum { MAX_THREADS = 64, MAX_REPORTS = 16 };
+
+typedef struct job { uint32_t first, last, seed, locators; uint64_t checked, mismatches, x[X_COUNT]; } job;
+static uint64_t reports;
+
+static void run( job *j ) {
+    char expected[256], got[256];
+    uint32_t d, i, seed = j->seed;
+    for( d = j->first; d < j->last; ++d ) {
+        for( i = 0; i <= j->locators; ++i ) {
+            // first pass: bare descriptor; then random api, rev and line
+            int64_t ec = ERR_ERROR | d, locator = 0;
+            const char *failed;
+            if( i ) {
+                seed = seed * 1664525u + 1013904223u, locator = (int64_t)(seed >> 8) << ERR_BIT_L;
+                seed = seed * 1664525u + 1013904223u, locator |= (int64_t)(seed >> 16) << ERR_BIT_R;
+                ec |= locator & ~(0x7fLL << ERR_BIT_V); // api glossaries are not registered here: keep api 0
+            }
+            ++j->checked;
+            if( (failed = check( ec, expected, got, j->x )) != 0 ) {
+                ++j->mismatches;
+                if( ERR_ATOMIC_ADD64( &reports, 1 ) < MAX_REPORTS ) {
+                    printf( "MISMATCH %s ERR_%016llX\n  expected: %s\n       got: %s\n", failed, (unsigned long long)ec, expected, got );
+                }
+            }
+        }
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI thread_main( LPVOID j ) { run( (job *)j ); return 0; }
+#else
+static void *thread_main( void *j ) { run( (job *)j ); return 0; }
+#endif
+
+// Wall-clock seconds
+static double now( void ) {
+#ifdef _WIN32
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency( &f ); QueryPerformanceCounter( &t );
+    return (double)t.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Online cores, to default one thread per core
+static int cores( void ) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo( &info );
+    return (int)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    return (int)sysconf( _SC_NPROCESSORS_ONLN );
+#else
+    return 4;
+#endif
+}
+
+int main( int argc, char **argv ) {
+    int threads = argc > 1 ? atoi( argv[1] ) : cores(), locators = argc > 2 ? atoi( argv[2] ) : 1, t, i;
+    job jobs[MAX_THREADS];
+    uint64_t checked = 0, mismatches = 0, x[X_COUNT] = { 0 };
+    char expected[256], got[256];
+    const char *failed;
+    double t0;
+
+    if( threads < 1 ) threads = 1;
+    if( threads > MAX_THREADS ) threads = MAX_THREADS;
+    if( locators < 0 ) locators = 0;
+
+    // non-errors and one well-known code first: a broken build fails here without flooding the threaded run
+    if( (failed = check( 0, expected, got, x )) != 0 || (failed = check( 12345, expected, got, x )) != 0 ||
+        (failed = check( ERROR64(NN_FILE | ERR_MISSING), expected, got, x )) != 0 ) {
+        printf( "MISMATCH %s\n  expected: %s\n       got: %s\n", failed, expected, got );
+        ++mismatches;
+    }
+
+    t0 = now();
+    for( t = 0; t < threads; ++t ) {
+        jobs[t].first = (uint32_t)((0x1000000ull * t) / threads), jobs[t].last = (uint32_t)((0x1000000ull * (t + 1)) / threads);
+        jobs[t].seed = 12345u + (uint32_t)t, jobs[t].locators = (uint32_t)locators, jobs[t].checked = jobs[t].mismatches = 0;
+        memset( jobs[t].x, 0, sizeof(jobs[t].x) );
+    }
+    {
+#ifdef _WIN32
+        HANDLE th[MAX_THREADS];
+        for( t = 0; t < threads; ++t ) th[t] = CreateThread( 0, 0, thread_main, &jobs[t], 0, 0 );
+        WaitForMultipleObjects( (DWORD)threads, th, TRUE, INFINITE );
+        for( t = 0; t < threads; ++t ) CloseHandle( th[t] );
+#else
+        pthread_t th[MAX_THREADS];
+        for( t = 0; t < threads; ++t ) pthread_create( &th[t], 0, thread_main, &jobs[t] );
+        for( t = 0; t < threads; ++t ) pthread_join( th[t], 0 );
+#endif
+    }
+    t0 = now() - t0;
+    for( t = 0; t < threads; ++t ) {
+        checked += jobs[t].checked, mismatches += jobs[t].mismatches;
+        for( i = 0; i < X_COUNT; ++i ) x[i] += jobs[t].x[i];
+    }
+    for( i = 0; i < X_COUNT; ++i ) printf( "%llu intended divergences: %s\n", (unsigned long long)x[i], x_names[i] );
+
+    printf( "%llu codes checked, %llu mismatches, %d threads, %.2f s, %.1f ns/code/thread\n",
+        (unsigned long long)checked, (unsigned long long)mismatches, threads, t0, t0 * 1e9 * threads / (double)checked );
+    return mismatches ? 1 : 0;
+}
+#endif
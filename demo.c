@@ -1,4 +1,14 @@
 #define ERROR64_BUILD_DEMO
+#define ERROR64_BINLOG
+#define ERROR64_CACHE
+#define ERROR64_STATS
+#define ERROR64_CHAIN
+#define ERROR64_SITES
+#define ERROR64_CATALOG
+#define ERROR64_SAMPLER
+#define ERROR64_SHM
+#define ERROR64_ASYNC
+#define ERROR64_TRACE
 #define ERROR64_DEFINE_IMPLEMENTATION
 #define ERRNO64_DEFINE_IMPLEMENTATION
 #include "error64.h"
@@ -27,6 +27,14 @@
 #ifndef ERROR64_H
 #define ERROR64_H
 
+// Strict C builds (-std=c99) on glibc hide POSIX (ftruncate for ERROR64_SHM): ask for it before the first system header.
+// Non-strict builds already see it; on macOS _POSIX_C_SOURCE would hide the Darwin extensions instead.
+#if defined(ERROR64_SHM) && defined(ERROR64_DEFINE_IMPLEMENTATION) && defined(__STRICT_ANSI__) && !defined(_WIN32) && \
+    !defined(__APPLE__) && !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stddef.h>
 #include <stdint.h>
 #ifdef __cplusplus
 extern "C" {
@@ -51,9 +59,129 @@ extern "C" {
 #define ERROR64_GET_U(ec)       ( (int32_t)((ec >> ERR_BIT_U) & 0x7fff) )
 
 // Extract human-readable error message to a [256] char buffer
-const char *strerror64( char buf[256], int64_t errno64 );
+const char *strerror64( char buf[256], int64_t ec );
+// Extract human-readable error message to a [cap] char buffer. Returns message length (no strlen() needed)
+size_t strerror64_n( char *buf, size_t cap, int64_t ec );
 // Extract human-readable error message to a [256] char buffer (extended info)
-const char *strerror64ex( char buf[256], int64_t errno64 );
+const char *strerror64ex( char buf[256], int64_t ec );
+
+// Zero-copy message: up to 3 ordered, non-empty fragments ("NOUN" "NOT" "ADJ") pointing into static/glossary storage.
+// Join them with single spaces to get the strerror64() message. Returns fragment count (0 for non-errors)
+typedef struct error64_fragment { const char *ptr; uint8_t len; } error64_fragment;
+struct error64_parts { int count; error64_fragment frag[3]; };
+int error64_parts( int64_t ec, struct error64_parts *out );
+
+// Localized messages: tables and word order travel with each call, so threads may use different locales concurrently.
+// Fragment order uses slots 0 noun, 1 negation, 2 attribute. Unset tables fall back to the built-in English ones.
+#define ERROR64_FRAGMENT(str) { str, (uint8_t)(sizeof(str) - 1) }
+typedef struct error64_locale {
+    const error64_fragment *nouns; int num_nouns;   // by U (NULL ptr entries: current glossaries, U >= num_nouns: "??")
+    const error64_fragment *attrs;                  // [256] by A (NULL ptr entries: English)
+    const error64_fragment *negated;                // optional [256] by A: one-word negation ("UNAVAILABLE"), replaces negation + attribute
+    error64_fragment negation;                      // "NOT" if ptr is NULL
+    uint8_t order[3], special_order[3];             // fragment order
+    const uint8_t *special;                         // optional [512] by (N << 8 | A): non-zero selects special_order. NULL: English rules
+    const char *separator;                          // between fragments. NULL: " "
+} error64_locale;
+// Extract message in a given locale (NULL: English, same as strerror64_n()) to a [cap] char buffer. Returns message length
+size_t strerror64_l_n( char *buf, size_t cap, int64_t ec, const error64_locale *loc );
+// Extract message in a given locale to a [256] char buffer
+const char *strerror64_l( char buf[256], int64_t ec, const error64_locale *loc );
+
+// Structured output: decoded fields plus message, straight into buf[cap] (no sprintf, no temporary strings).
+// JSON:   {"code":"8000000585158098","error":1,"api":0,"rev":0,"line":1413,"neg":0,"attr":43,"noun":152,"message":"SERVICE FAILED"}
+// logfmt: code=8000000585158098 error=1 api=0 rev=0 line=1413 neg=0 attr=43 noun=152 msg="SERVICE FAILED"
+// Both return the written length, or 0 (and an empty string) if the record does not fit: output is never cut in half
+size_t error64_to_json( char *buf, size_t cap, int64_t ec );
+size_t error64_to_logfmt( char *buf, size_t cap, int64_t ec );
+// Streaming writer: appends one record per line (JSON Lines or logfmt) to a heap arena grown with realloc()
+#define ERROR64_JSON   0
+#define ERROR64_LOGFMT 1
+typedef struct error64_writer { char *data; size_t len, cap; int format; } error64_writer;
+// Start an empty writer, with an optional initial arena size in bytes
+void error64_writer_init( error64_writer *w, int format, size_t reserve );
+// Append a record and a '\n'. data stays '\0'-terminated. Returns 0 if out of memory (nothing appended then)
+int error64_writer_append( error64_writer *w, int64_t ec );
+// Free the arena and reset the writer
+void error64_writer_free( error64_writer *w );
+
+// Batch decoding of E/V/R/L/N/A/U fields into structure-of-arrays output (each array holds n entries). AVX2/NEON when available
+struct error64_fields { uint8_t *e, *v; uint16_t *r, *l; uint8_t *n, *a; uint16_t *u; };
+void error64_decode_batch( const int64_t *codes, size_t n, struct error64_fields *soa_out );
+// Batch strerror64() into one arena: message i is arena + offsets[i], '\0'-terminated, length offsets[i+1] - offsets[i] - 1.
+// Rendering stops when fewer than 256 bytes are left. Returns number of messages rendered (offsets[] needs n+1 entries)
+size_t strerror64_batch( const int64_t *codes, size_t n, char *arena, size_t cap, uint32_t *offsets );
+
+// Compact wire format. Per record: tag byte (0x80 E, 0x40 N, 0x20 api/rev follow), [V byte, R varint], L varint, A byte, U varint.
+// Varints are LEB128. api/rev are only sent when they differ from the previous record of the batch, so the usual record
+// takes 4-6 bytes. Lossless for every int64_t (non-errors included).
+#define ERROR64_WIRE_MAX 12             // worst-case bytes per record
+// Encode codes[n] into out[cap]. Stops when fewer than ERROR64_WIRE_MAX bytes are left.
+// Returns number of codes encoded; *len receives the bytes written
+size_t error64_encode( const int64_t *codes, size_t n, uint8_t *out, size_t cap, size_t *len );
+// Decode up to n codes of a batch. Stops at the end of input or at a malformed record. Returns number of codes decoded
+size_t error64_decode( const uint8_t *in, size_t len, int64_t *codes, size_t n );
+
+// Install a dense noun table indexed by the U field: names[count] (and optional lens[count], else strlen() is used).
+// Unlisted nouns resolve to "??". Passing NULL names routes lookups to glossary() again.
+// Register at startup, before other threads format errors. The built-in NN_xxx glossary is installed by default.
+void error64_glossary_register( const char *const *names, const uint8_t *lens, int count );
+// Same as above, for codes raised by a given ERR_VER_NO api [0..127] only, so every library can ship its own nouns.
+// api -1 is the default glossary, used by every api without a glossary of its own. NULL names clears the slot.
+// Returns 0, or -1 (nothing registered) when api is out of [-1..127]
+int error64_glossary_register_api( int api, const char *const *names, const uint8_t *lens, int count );
+// Callback flavor of error64_glossary_register_api(). NULL fn clears the slot (api -1: restores glossary()). Returns 0 or -1
+int error64_glossary_register_fn( int api, const char *(*fn)( int ) );
+// Extract human-readable error message to a [cap] char buffer (extended info). Returns message length
+size_t strerror64ex_n( char *buf, size_t cap, int64_t ec );
+// Parse strerror64() or strerror64ex() text back into a code. Short messages only carry E+N+A+U fields (nouns are looked up
+// as api 0 prints them: its glossary, a loaded catalog, or the default glossary, table or glossary() callback); extended
+// messages return the full code. Returns 0 if the text cannot be parsed.
+// Lookups are hashed: the first call (and the first call after a glossary registration) builds the indexes.
+// Thread-safe: indexes are built aside and published with an atomic swap, so concurrent parsers never see a half-built
+// index. A parser racing a registration may still resolve nouns against the previous glossary (register at startup, as
+// above). Indexes replaced by registrations are kept allocated (8 KB each), since other parsers may still be reading them.
+int64_t strtoerror64( const char *s, size_t len );
+
+// Extended 128-bit code: the 64-bit code plus a site word { file id (32 bits), full __LINE__ (32 bits) }.
+// The L field wraps at 65536 and cannot tell files apart; the site word can, so group-by/dedup need integers only.
+// File ids are FNV-1a hashes of __FILE__, computed at compile time in C++11 and at runtime (per raise) in C.
+// __FILE__ includes the path as given to the compiler: #define ERROR64_FILE_ID per source file to use ids of your own.
+typedef struct error128_t { int64_t code; uint64_t site; } error128_t;
+#define ERROR128(x)             error128_make( ERROR64(x), ERROR64_FILE_ID, __LINE__ )
+#define ERROR128_GET_FILE(ec)   ( (uint32_t)((ec).site >> 32) )
+#define ERROR128_GET_LINE(ec)   ( (uint32_t)((ec).site & 0xffffffff) )
+// Extract human-readable error message to a [cap] char buffer (extended info + site). Returns message length
+size_t strerror128ex_n( char *buf, size_t cap, error128_t ec );
+// Extract human-readable error message to a [256] char buffer (extended info + site)
+const char *strerror128ex( char buf[256], error128_t ec );
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define ERR_CONSTEXPR constexpr
+#else
+#define ERR_CONSTEXPR
+#endif
+static inline ERR_CONSTEXPR uint32_t err_fnv1a( const char *s, uint32_t h ) {
+    return *s ? err_fnv1a( s + 1, (h ^ (uint8_t)*s) * 16777619u ) : h;
+}
+// File id of a path, as used by ERROR128(). Handy to map ids back to file names
+static inline ERR_CONSTEXPR uint32_t error64_file_id( const char *path ) {
+    return err_fnv1a( path, 2166136261u );
+}
+static inline error128_t error128_make( int64_t code, uint32_t file, uint32_t line ) {
+    error128_t ec;
+    ec.code = code;
+    ec.site = ((uint64_t)file << 32) | line;
+    return ec;
+}
+#ifndef ERROR64_FILE_ID
+#   if defined(__cplusplus) && __cplusplus >= 201103L
+extern "C++" { template<uint32_t id> struct err_file_id_constant { static const uint32_t value = id; }; }
+#       define ERROR64_FILE_ID  ( err_file_id_constant< error64_file_id(__FILE__) >::value )
+#   else
+#       define ERROR64_FILE_ID  error64_file_id(__FILE__)
+#   endif
+#endif
 
 // Also, provide the meanings to add extra information to a 64-bit, thread-local-safe, errno variable: errno64.
 // Pretty much like errno, errno64 is an writable thread-safe l-value and the implementation of how the l-value is read and written is hidden from the user.
@@ -64,313 +192,438 @@ const char *strerror64ex( char buf[256], int64_t errno64 );
 #       define ERR_TLS(x) __declspec(thread) x   // Visual C++, Intel C/C++ (Windows systems), C++Builder and Digital Mars C++
 #   endif
 #endif
-extern ERR_TLS(int64_t) errno64;
-
-// Error attributes (1LL << YY)
-#define ERR_A                   (   1LL << ERR_BIT_A )
-#define ERR_ACK                 (   2LL << ERR_BIT_A )
-#define ERR_ACTIVE              (   3LL << ERR_BIT_A )
-#define ERR_ALIGNED             (   4LL << ERR_BIT_A )
-#define ERR_ALLOWED             (   5LL << ERR_BIT_A )
-#define ERR_ASSIGNED            (   6LL << ERR_BIT_A )
-#define ERR_ATTACHED            (   7LL << ERR_BIT_A )
-#define ERR_ATTEMPTED           (   8LL << ERR_BIT_A )
-#define ERR_AUTHORIZED          (   9LL << ERR_BIT_A )
-#define ERR_AVAILABLE           (  10LL << ERR_BIT_A )
-#define ERR_BAD                 (  11LL << ERR_BIT_A )
-#define ERR_BLOCKED             (  12LL << ERR_BIT_A )
-#define ERR_BROKEN              (  13LL << ERR_BIT_A )
-#define ERR_BUILT               (  14LL << ERR_BIT_A )
-#define ERR_BUSY                (  15LL << ERR_BIT_A )
-#define ERR_CLOSED              (  16LL << ERR_BIT_A )
-#define ERR_COLLIDED            (  17LL << ERR_BIT_A )
-#define ERR_COMPILED            (  18LL << ERR_BIT_A )
-#define ERR_COMPLETE            (  19LL << ERR_BIT_A )
-#define ERR_CONFLICTED          (  20LL << ERR_BIT_A )
-#define ERR_CONNECTED           (  21LL << ERR_BIT_A )
-#define ERR_CONSTRUCTED         (  22LL << ERR_BIT_A )
-#define ERR_CREATED             (  23LL << ERR_BIT_A )
-#define ERR_DEFINED             (  24LL << ERR_BIT_A )
-#define ERR_DENIED              (  25LL << ERR_BIT_A )
-#define ERR_DEPARTED            (  26LL << ERR_BIT_A )
-#define ERR_DESTRUCTED          (  27LL << ERR_BIT_A )
-#define ERR_DETACHED            (  28LL << ERR_BIT_A )
-#define ERR_DETECTED            (  29LL << ERR_BIT_A )
-#define ERR_DISABLED            (  30LL << ERR_BIT_A )
-#define ERR_DOWN                (  31LL << ERR_BIT_A )
-#define ERR_DOWNLOADED          (  32LL << ERR_BIT_A )
-#define ERR_EMPTY               (  33LL << ERR_BIT_A )
-#define ERR_ENABLED             (  34LL << ERR_BIT_A )
-#define ERR_ENHANCED            (  35LL << ERR_BIT_A )
-#define ERR_ENOUGH              (  36LL << ERR_BIT_A )
-#define ERR_EXCEEDED            (  37LL << ERR_BIT_A )
-#define ERR_EXCHANGED           (  38LL << ERR_BIT_A )
-#define ERR_EXECUTABLE          (  39LL << ERR_BIT_A )
-#define ERR_EXISTS              (  40LL << ERR_BIT_A )
-#define ERR_EXPIRED             (  41LL << ERR_BIT_A )
-#define ERR_EXTENDED            (  42LL << ERR_BIT_A )
-#define ERR_FAILED              (  43LL << ERR_BIT_A )
-#define ERR_FALSE               (  44LL << ERR_BIT_A )
-#define ERR_FATAL               (  45LL << ERR_BIT_A )
-#define ERR_FORBIDDEN           (  46LL << ERR_BIT_A )
-#define ERR_FORMATTED           (  47LL << ERR_BIT_A )
-#define ERR_FOUND               (  48LL << ERR_BIT_A )
-#define ERR_FULL                (  49LL << ERR_BIT_A )
-#define ERR_GONE                (  50LL << ERR_BIT_A )
-#define ERR_GOOD                (  51LL << ERR_BIT_A )
-#define ERR_HALTED              (  52LL << ERR_BIT_A )
-#define ERR_HIDDEN              (  53LL << ERR_BIT_A )
-#define ERR_HOLD                (  54LL << ERR_BIT_A )
-#define ERR_IDLE                (  55LL << ERR_BIT_A )
-#define ERR_ILLEGAL             (  56LL << ERR_BIT_A )
-#define ERR_IMPLEMENTED         (  57LL << ERR_BIT_A )
-#define ERR_IN_PROGRESS         (  58LL << ERR_BIT_A )
-#define ERR_IN_USE              (  59LL << ERR_BIT_A )
-#define ERR_INITIALIZED         (  60LL << ERR_BIT_A )
-#define ERR_INSERTED            (  61LL << ERR_BIT_A )
-#define ERR_INSTALLED           (  62LL << ERR_BIT_A )
-#define ERR_INTERRUPTED         (  63LL << ERR_BIT_A )
-#define ERR_JOINED              (  64LL << ERR_BIT_A )
-#define ERR_KNOWN               (  65LL << ERR_BIT_A )
-#define ERR_LINKED              (  66LL << ERR_BIT_A )
-#define ERR_LOADED              (  67LL << ERR_BIT_A )
-#define ERR_LOCAL               (  68LL << ERR_BIT_A )
-#define ERR_LOCKED              (  69LL << ERR_BIT_A )
-#define ERR_LOOPED              (  70LL << ERR_BIT_A )
-#define ERR_LOST                (  71LL << ERR_BIT_A )
-#define ERR_MERGED              (  72LL << ERR_BIT_A )
-#define ERR_MISSING             (  73LL << ERR_BIT_A )
-#define ERR_MOUNTED             (  74LL << ERR_BIT_A )
-#define ERR_NEEDED              (  75LL << ERR_BIT_A )
-#define ERR_NO                  (  76LL << ERR_BIT_A )
-#define ERR_NO_SUCH             (  77LL << ERR_BIT_A )
-#define ERR_OFF                 (  78LL << ERR_BIT_A )
-#define ERR_ON                  (  79LL << ERR_BIT_A )
-#define ERR_ONLINE              (  80LL << ERR_BIT_A )
-#define ERR_OPEN                (  81LL << ERR_BIT_A )
-#define ERR_ORDERED             (  82LL << ERR_BIT_A )
-#define ERR_OUT_OF              (  83LL << ERR_BIT_A )
-#define ERR_OUT_OF_RANGE        (  84LL << ERR_BIT_A )
-#define ERR_OVERFLOW            (  85LL << ERR_BIT_A )
-#define ERR_PADDED              (  86LL << ERR_BIT_A )
-#define ERR_PARTED              (  87LL << ERR_BIT_A )
-#define ERR_PERMITTED           (  88LL << ERR_BIT_A )
-#define ERR_POPPED              (  89LL << ERR_BIT_A )
-#define ERR_PRELOADED           (  90LL << ERR_BIT_A )
-#define ERR_PROCESSABLE         (  91LL << ERR_BIT_A )
-#define ERR_PROVIDED            (  92LL << ERR_BIT_A )
-#define ERR_PUSHED              (  93LL << ERR_BIT_A )
-#define ERR_REACHABLE           (  94LL << ERR_BIT_A )
-#define ERR_READABLE            (  95LL << ERR_BIT_A )
-#define ERR_RECEIVED            (  96LL << ERR_BIT_A )
-#define ERR_REFUSED             (  97LL << ERR_BIT_A )
-#define ERR_REGISTERED          (  98LL << ERR_BIT_A )
-#define ERR_REJECTED            (  99LL << ERR_BIT_A )
-#define ERR_RELEASED            ( 100LL << ERR_BIT_A )
-#define ERR_REMOTE              ( 101LL << ERR_BIT_A )
-#define ERR_REMOVED             ( 102LL << ERR_BIT_A )
-#define ERR_RENDERABLE          ( 103LL << ERR_BIT_A )
-#define ERR_RESERVED            ( 104LL << ERR_BIT_A )
-#define ERR_RESET               ( 105LL << ERR_BIT_A )
-#define ERR_RESPONDING          ( 106LL << ERR_BIT_A )
-#define ERR_RETRIED             ( 107LL << ERR_BIT_A )
-#define ERR_RIGHT               ( 108LL << ERR_BIT_A )
-#define ERR_RUNNING             ( 109LL << ERR_BIT_A )
-#define ERR_SENT                ( 110LL << ERR_BIT_A )
-#define ERR_SHARED              ( 111LL << ERR_BIT_A )
-#define ERR_SORTED              ( 112LL << ERR_BIT_A )
-#define ERR_SPECIFIED           ( 113LL << ERR_BIT_A )
-#define ERR_SPLITTED            ( 114LL << ERR_BIT_A )
-#define ERR_STALLED             ( 115LL << ERR_BIT_A )
-#define ERR_STOPPED             ( 116LL << ERR_BIT_A )
-#define ERR_SUCEEDED            ( 117LL << ERR_BIT_A )
-#define ERR_SUITABLE            ( 118LL << ERR_BIT_A )
-#define ERR_SUPPORTED           ( 119LL << ERR_BIT_A )
-#define ERR_SYNCHRONIZED        ( 120LL << ERR_BIT_A )
-#define ERR_TERMINATED          ( 121LL << ERR_BIT_A )
-#define ERR_THROWN              ( 122LL << ERR_BIT_A )
-#define ERR_TIMED_OUT           ( 123LL << ERR_BIT_A )
-#define ERR_TOO_COMPLEX         ( 124LL << ERR_BIT_A )
-#define ERR_TOO_FEW             ( 125LL << ERR_BIT_A )
-#define ERR_TOO_LARGE           ( 126LL << ERR_BIT_A )
-#define ERR_TOO_LONG            ( 127LL << ERR_BIT_A )
-#define ERR_TOO_MANY            ( 128LL << ERR_BIT_A )
-#define ERR_TOO_MUCH            ( 129LL << ERR_BIT_A )
-#define ERR_TOO_SIMPLE          ( 130LL << ERR_BIT_A )
-#define ERR_TOO_SMALL           ( 131LL << ERR_BIT_A )
-#define ERR_TRIGGERED           ( 132LL << ERR_BIT_A )
-#define ERR_TRUE                ( 133LL << ERR_BIT_A )
-#define ERR_UNBLOCKED           ( 134LL << ERR_BIT_A )
-#define ERR_UNDERFLOW           ( 135LL << ERR_BIT_A )
-#define ERR_UNINITIALIZED       ( 136LL << ERR_BIT_A )
-#define ERR_UNINSTALLED         ( 137LL << ERR_BIT_A )
-#define ERR_UNIQUE              ( 138LL << ERR_BIT_A )
-#define ERR_UNLOADED            ( 139LL << ERR_BIT_A )
-#define ERR_UNLOCKED            ( 140LL << ERR_BIT_A )
-#define ERR_UNSORTED            ( 141LL << ERR_BIT_A )
-#define ERR_UP                  ( 142LL << ERR_BIT_A )
-#define ERR_UPDATED             ( 143LL << ERR_BIT_A )
-#define ERR_UPGRADED            ( 144LL << ERR_BIT_A )
-#define ERR_UPLOADED            ( 145LL << ERR_BIT_A )
-#define ERR_USED                ( 146LL << ERR_BIT_A )
-#define ERR_VALID               ( 147LL << ERR_BIT_A )
-#define ERR_VISIBLE             ( 148LL << ERR_BIT_A )
-#define ERR_WORKING             ( 149LL << ERR_BIT_A )
-#define ERR_WRITABLE            ( 150LL << ERR_BIT_A )
-#define ERR_WRONG               ( 151LL << ERR_BIT_A )
-
-// Error attributes (negate forms)
-#define ERR_NOT_A               ( ERR_NOT | ERR_A )
-#define ERR_NOT_ACK             ( ERR_NOT | ERR_ACK )
-#define ERR_NOT_ACTIVE          ( ERR_NOT | ERR_ACTIVE )
-#define ERR_NOT_ALIGNED         ( ERR_NOT | ERR_ALIGNED )
-#define ERR_NOT_ALLOWED         ( ERR_NOT | ERR_ALLOWED )
-#define ERR_NOT_ASSIGNED        ( ERR_NOT | ERR_ASSIGNED )
-#define ERR_NOT_ATTACHED        ( ERR_NOT | ERR_ATTACHED )
-#define ERR_NOT_ATTEMPTED       ( ERR_NOT | ERR_ATTEMPTED )
-#define ERR_NOT_AUTHORIZED      ( ERR_NOT | ERR_AUTHORIZED )
-#define ERR_NOT_AVAILABLE       ( ERR_NOT | ERR_AVAILABLE )
-#define ERR_NOT_BAD             ( ERR_NOT | ERR_BAD )
-#define ERR_NOT_BLOCKED         ( ERR_NOT | ERR_BLOCKED )
-#define ERR_NOT_BROKEN          ( ERR_NOT | ERR_BROKEN )
-#define ERR_NOT_BUILT           ( ERR_NOT | ERR_BUILT )
-#define ERR_NOT_BUSY            ( ERR_NOT | ERR_BUSY )
-#define ERR_NOT_CLOSED          ( ERR_NOT | ERR_CLOSED )
-#define ERR_NOT_COLLIDED        ( ERR_NOT | ERR_COLLIDED )
-#define ERR_NOT_COMPILED        ( ERR_NOT | ERR_COMPILED )
-#define ERR_NOT_COMPLETE        ( ERR_NOT | ERR_COMPLETE )
-#define ERR_NOT_CONFLICTED      ( ERR_NOT | ERR_CONFLICTED )
-#define ERR_NOT_CONNECTED       ( ERR_NOT | ERR_CONNECTED )
-#define ERR_NOT_CONSTRUCTED     ( ERR_NOT | ERR_CONSTRUCTED )
-#define ERR_NOT_CREATED         ( ERR_NOT | ERR_CREATED )
-#define ERR_NOT_DEFINED         ( ERR_NOT | ERR_DEFINED )
-#define ERR_NOT_DENIED          ( ERR_NOT | ERR_DENIED )
-#define ERR_NOT_DEPARTED        ( ERR_NOT | ERR_DEPARTED )
-#define ERR_NOT_DESTRUCTED      ( ERR_NOT | ERR_DESTRUCTED )
-#define ERR_NOT_DETACHED        ( ERR_NOT | ERR_DETACHED )
-#define ERR_NOT_DETECTED        ( ERR_NOT | ERR_DETECTED )
-#define ERR_NOT_DISABLED        ( ERR_NOT | ERR_DISABLED )
-#define ERR_NOT_DOWN            ( ERR_NOT | ERR_DOWN )
-#define ERR_NOT_DOWNLOADED      ( ERR_NOT | ERR_DOWNLOADED )
-#define ERR_NOT_EMPTY           ( ERR_NOT | ERR_EMPTY )
-#define ERR_NOT_ENABLED         ( ERR_NOT | ERR_ENABLED )
-#define ERR_NOT_ENHANCED        ( ERR_NOT | ERR_ENHANCED )
-#define ERR_NOT_ENOUGH          ( ERR_NOT | ERR_ENOUGH )
-#define ERR_NOT_EXCEEDED        ( ERR_NOT | ERR_EXCEEDED )
-#define ERR_NOT_EXCHANGED       ( ERR_NOT | ERR_EXCHANGED )
-#define ERR_NOT_EXECUTABLE      ( ERR_NOT | ERR_EXECUTABLE )
-#define ERR_NOT_EXISTS          ( ERR_NOT | ERR_EXISTS )
-#define ERR_NOT_EXPIRED         ( ERR_NOT | ERR_EXPIRED )
-#define ERR_NOT_EXTENDED        ( ERR_NOT | ERR_EXTENDED )
-#define ERR_NOT_FAILED          ( ERR_NOT | ERR_FAILED )
-#define ERR_NOT_FALSE           ( ERR_NOT | ERR_FALSE )
-#define ERR_NOT_FATAL           ( ERR_NOT | ERR_FATAL )
-#define ERR_NOT_FORBIDDEN       ( ERR_NOT | ERR_FORBIDDEN )
-#define ERR_NOT_FORMATTED       ( ERR_NOT | ERR_FORMATTED )
-#define ERR_NOT_FOUND           ( ERR_NOT | ERR_FOUND )
-#define ERR_NOT_FULL            ( ERR_NOT | ERR_FULL )
-#define ERR_NOT_GONE            ( ERR_NOT | ERR_GONE )
-#define ERR_NOT_GOOD            ( ERR_NOT | ERR_GOOD )
-#define ERR_NOT_HALTED          ( ERR_NOT | ERR_HALTED )
-#define ERR_NOT_HIDDEN          ( ERR_NOT | ERR_HIDDEN )
-#define ERR_NOT_HOLD            ( ERR_NOT | ERR_HOLD )
-#define ERR_NOT_IDLE            ( ERR_NOT | ERR_IDLE )
-#define ERR_NOT_ILLEGAL         ( ERR_NOT | ERR_ILLEGAL )
-#define ERR_NOT_IMPLEMENTED     ( ERR_NOT | ERR_IMPLEMENTED )
-#define ERR_NOT_IN_PROGRESS     ( ERR_NOT | ERR_IN_PROGRESS )
-#define ERR_NOT_IN_USE          ( ERR_NOT | ERR_IN_USE )
-#define ERR_NOT_INITIALIZED     ( ERR_NOT | ERR_INITIALIZED )
-#define ERR_NOT_INSERTED        ( ERR_NOT | ERR_INSERTED )
-#define ERR_NOT_INSTALLED       ( ERR_NOT | ERR_INSTALLED )
-#define ERR_NOT_INTERRUPTED     ( ERR_NOT | ERR_INTERRUPTED )
-#define ERR_NOT_JOINED          ( ERR_NOT | ERR_JOINED )
-#define ERR_NOT_KNOWN           ( ERR_NOT | ERR_KNOWN )
-#define ERR_NOT_LINKED          ( ERR_NOT | ERR_LINKED )
-#define ERR_NOT_LOADED          ( ERR_NOT | ERR_LOADED )
-#define ERR_NOT_LOCAL           ( ERR_NOT | ERR_LOCAL )
-#define ERR_NOT_LOCKED          ( ERR_NOT | ERR_LOCKED )
-#define ERR_NOT_LOOPED          ( ERR_NOT | ERR_LOOPED )
-#define ERR_NOT_LOST            ( ERR_NOT | ERR_LOST )
-#define ERR_NOT_MERGED          ( ERR_NOT | ERR_MERGED )
-#define ERR_NOT_MISSING         ( ERR_NOT | ERR_MISSING )
-#define ERR_NOT_MOUNTED         ( ERR_NOT | ERR_MOUNTED )
-#define ERR_NOT_NEEDED          ( ERR_NOT | ERR_NEEDED )
-#define ERR_NOT_NO              ( ERR_NOT | ERR_NO )
-#define ERR_NOT_NO_SUCH         ( ERR_NOT | ERR_NO_SUCH )
-#define ERR_NOT_OFF             ( ERR_NOT | ERR_OFF )
-#define ERR_NOT_ON              ( ERR_NOT | ERR_ON )
-#define ERR_NOT_ONLINE          ( ERR_NOT | ERR_ONLINE )
-#define ERR_NOT_OPEN            ( ERR_NOT | ERR_OPEN )
-#define ERR_NOT_ORDERED         ( ERR_NOT | ERR_ORDERED )
-#define ERR_NOT_OUT_OF          ( ERR_NOT | ERR_OUT_OF )
-#define ERR_NOT_OUT_OF_RANGE    ( ERR_NOT | ERR_OUT_OF_RANGE )
-#define ERR_NOT_OVERFLOW        ( ERR_NOT | ERR_OVERFLOW )
-#define ERR_NOT_PADDED          ( ERR_NOT | ERR_PADDED )
-#define ERR_NOT_PARTED          ( ERR_NOT | ERR_PARTED )
-#define ERR_NOT_PERMITTED       ( ERR_NOT | ERR_PERMITTED )
-#define ERR_NOT_POPPED          ( ERR_NOT | ERR_POPPED )
-#define ERR_NOT_PRELOADED       ( ERR_NOT | ERR_PRELOADED )
-#define ERR_NOT_PROCESSABLE     ( ERR_NOT | ERR_PROCESSABLE )
-#define ERR_NOT_PROVIDED        ( ERR_NOT | ERR_PROVIDED )
-#define ERR_NOT_PUSHED          ( ERR_NOT | ERR_PUSHED )
-#define ERR_NOT_REACHABLE       ( ERR_NOT | ERR_REACHABLE )
-#define ERR_NOT_READABLE        ( ERR_NOT | ERR_READABLE )
-#define ERR_NOT_RECEIVED        ( ERR_NOT | ERR_RECEIVED )
-#define ERR_NOT_REFUSED         ( ERR_NOT | ERR_REFUSED )
-#define ERR_NOT_REGISTERED      ( ERR_NOT | ERR_REGISTERED )
-#define ERR_NOT_REJECTED        ( ERR_NOT | ERR_REJECTED )
-#define ERR_NOT_RELEASED        ( ERR_NOT | ERR_RELEASED )
-#define ERR_NOT_REMOTE          ( ERR_NOT | ERR_REMOTE )
-#define ERR_NOT_REMOVED         ( ERR_NOT | ERR_REMOVED )
-#define ERR_NOT_RENDERABLE      ( ERR_NOT | ERR_RENDERABLE )
-#define ERR_NOT_RESERVED        ( ERR_NOT | ERR_RESERVED )
-#define ERR_NOT_RESET           ( ERR_NOT | ERR_RESET )
-#define ERR_NOT_RESPONDING      ( ERR_NOT | ERR_RESPONDING )
-#define ERR_NOT_RETRIED         ( ERR_NOT | ERR_RETRIED )
-#define ERR_NOT_RIGHT           ( ERR_NOT | ERR_RIGHT )
-#define ERR_NOT_RUNNING         ( ERR_NOT | ERR_RUNNING )
-#define ERR_NOT_SENT            ( ERR_NOT | ERR_SENT )
-#define ERR_NOT_SHARED          ( ERR_NOT | ERR_SHARED )
-#define ERR_NOT_SORTED          ( ERR_NOT | ERR_SORTED )
-#define ERR_NOT_SPECIFIED       ( ERR_NOT | ERR_SPECIFIED )
-#define ERR_NOT_SPLITTED        ( ERR_NOT | ERR_SPLITTED )
-#define ERR_NOT_STALLED         ( ERR_NOT | ERR_STALLED )
-#define ERR_NOT_STOPPED         ( ERR_NOT | ERR_STOPPED )
-#define ERR_NOT_SUCEEDED        ( ERR_NOT | ERR_SUCEEDED )
-#define ERR_NOT_SUITABLE        ( ERR_NOT | ERR_SUITABLE )
-#define ERR_NOT_SUPPORTED       ( ERR_NOT | ERR_SUPPORTED )
-#define ERR_NOT_SYNCHRONIZED    ( ERR_NOT | ERR_SYNCHRONIZED )
-#define ERR_NOT_TERMINATED      ( ERR_NOT | ERR_TERMINATED )
-#define ERR_NOT_THROWN          ( ERR_NOT | ERR_THROWN )
-#define ERR_NOT_TIMED_OUT       ( ERR_NOT | ERR_TIMED_OUT )
-#define ERR_NOT_TOO_COMPLEX     ( ERR_NOT | ERR_TOO_COMPLEX )
-#define ERR_NOT_TOO_FEW         ( ERR_NOT | ERR_TOO_FEW )
-#define ERR_NOT_TOO_LARGE       ( ERR_NOT | ERR_TOO_LARGE )
-#define ERR_NOT_TOO_LONG        ( ERR_NOT | ERR_TOO_LONG )
-#define ERR_NOT_TOO_MANY        ( ERR_NOT | ERR_TOO_MANY )
-#define ERR_NOT_TOO_MUCH        ( ERR_NOT | ERR_TOO_MUCH )
-#define ERR_NOT_TOO_SIMPLE      ( ERR_NOT | ERR_TOO_SIMPLE )
-#define ERR_NOT_TOO_SMALL       ( ERR_NOT | ERR_TOO_SMALL )
-#define ERR_NOT_TRIGGERED       ( ERR_NOT | ERR_TRIGGERED )
-#define ERR_NOT_TRUE            ( ERR_NOT | ERR_TRUE )
-#define ERR_NOT_UNBLOCKED       ( ERR_NOT | ERR_UNBLOCKED )
-#define ERR_NOT_UNDERFLOW       ( ERR_NOT | ERR_UNDERFLOW )
-#define ERR_NOT_UNINITIALIZED   ( ERR_NOT | ERR_UNINITIALIZED )
-#define ERR_NOT_UNINSTALLED     ( ERR_NOT | ERR_UNINSTALLED )
-#define ERR_NOT_UNIQUE          ( ERR_NOT | ERR_UNIQUE )
-#define ERR_NOT_UNLOADED        ( ERR_NOT | ERR_UNLOADED )
-#define ERR_NOT_UNLOCKED        ( ERR_NOT | ERR_UNLOCKED )
-#define ERR_NOT_UNSORTED        ( ERR_NOT | ERR_UNSORTED )
-#define ERR_NOT_UP              ( ERR_NOT | ERR_UP )
-#define ERR_NOT_UPDATED         ( ERR_NOT | ERR_UPDATED )
-#define ERR_NOT_UPGRADED        ( ERR_NOT | ERR_UPGRADED )
-#define ERR_NOT_UPLOADED        ( ERR_NOT | ERR_UPLOADED )
-#define ERR_NOT_USED            ( ERR_NOT | ERR_USED )
-#define ERR_NOT_VALID           ( ERR_NOT | ERR_VALID )
-#define ERR_NOT_VISIBLE         ( ERR_NOT | ERR_VISIBLE )
-#define ERR_NOT_WORKING         ( ERR_NOT | ERR_WORKING )
-#define ERR_NOT_WRITABLE        ( ERR_NOT | ERR_WRITABLE )
-#define ERR_NOT_WRONG           ( ERR_NOT | ERR_WRONG )
+// Position-independent builds default to the general-dynamic TLS model (a __tls_get_addr() call per access).
+// Executables (PIE or not) use initial-exec, which is always safe there. Shared libraries keep the default: a library built
+// with initial-exec fails to dlopen() once static TLS space runs out ("cannot allocate memory in static TLS block").
+// #define ERROR64_TLS_INITIAL_EXEC to opt in for shared libraries that are only ever linked at startup, never dlopen()'ed.
+#ifndef ERR_TLS_MODEL
+#   if (defined(__GNUC__) || defined(__clang__)) && !defined(_WIN32) && !defined(__APPLE__) && \
+       ( !defined(__PIC__) || defined(__PIE__) || defined(ERROR64_TLS_INITIAL_EXEC) )
+#       define ERR_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#   else
+#       define ERR_TLS_MODEL
+#   endif
+#endif
+#ifndef ERROR64_TASK_LOCAL
+extern ERR_TLS(int64_t) errno64 ERR_TLS_MODEL;
+#else
+// Task-local mode (#define ERROR64_TASK_LOCAL): errno64 is the l-value returned by a pluggable location hook, like errno.
+// Schedulers install a hook returning the running task's slot, so errno64 follows the task rather than the OS thread.
+typedef int64_t *(*error64_location_fn)( void );
+// Current errno64 slot. Without a hook, the calling thread's slot
+int64_t *error64_location( void );
+// Install location hook (NULL restores thread-local storage). Install at startup, before raising errors
+void error64_set_location_hook( error64_location_fn fn );
+#define errno64 (*error64_location())
+#endif
+
+// Optional binary log (#define ERROR64_BINLOG): keep raw {timestamp, code} records in a per-thread ring and format them later.
+// Logging is a plain store into the calling thread's ring: no locks, no formatting on the error path. Each thread's ring is
+// heap-allocated on its first log and linked into a global list, so a crash handler or admin thread can dump every worker.
+// Rings outlive their threads (post-mortem dumps see them); error64_log_detach() hands the ring over to the next new thread.
+#ifdef ERROR64_BINLOG
+#include <stdio.h>
+#ifndef ERROR64_BINLOG_CAPACITY
+#define ERROR64_BINLOG_CAPACITY 1024    // records per thread (power of two)
+#endif
+typedef struct error64_record { uint64_t timestamp; int64_t code; } error64_record;
+// Set errno64 and log it (raise hooks included: stats, chain, board, trace)
+#define ERROR64_LOG(x) ( errno64 = error64_log( ERR_RAISE_HOOK( ERROR64_SITE(x), errno64 ) ) )
+// Append a code to the calling thread's ring (timestamp in nanoseconds since epoch). Returns code
+int64_t error64_log( int64_t code );
+// Copy the calling thread's ring (oldest first) into out[max]. Returns number of records copied
+size_t error64_log_dump( error64_record *out, size_t max );
+// Called once per ring by error64_log_dump_all(): ring number (registration order), its records (oldest first) and user
+typedef void (*error64_log_visitor)( int ring, const error64_record *recs, size_t n, void *user );
+// Copy every thread's ring in turn into out[max] and pass it to fn. Safe from any thread while the owners keep logging:
+// records overwritten during the copy are dropped. No allocations, so usable from crash handlers. Returns number of rings
+size_t error64_log_dump_all( error64_record *out, size_t max, error64_log_visitor fn, void *user );
+// Release the calling thread's ring for reuse (call before a thread exits, in thread pools that churn threads)
+void error64_log_detach( void );
+// Write the calling thread's ring to a binary file (native endianness). Returns number of records written
+size_t error64_log_save( FILE *fp );
+// Decode records as text lines ("timestamp strerror64ex()") into fp. Returns number of records decoded
+size_t error64_log_decode( FILE *fp, const error64_record *recs, size_t n );
+#endif
+
+// Optional external catalog (#define ERROR64_CATALOG): nouns and attributes mapped read-only from a file, no parsing.
+// Layout (little-endian): error64_catalog_header, uint32_t noun_offsets[nouns+1], uint32_t attr_offsets[attrs+1],
+// then the pool of '\0'-terminated strings. Entry i spans pool + offsets[i], length offsets[i+1] - offsets[i] - 1.
+// A loaded catalog replaces the default glossary (per-api glossaries still win), and attributes too when attrs > 0.
+#ifdef ERROR64_CATALOG
+#define ERROR64_CATALOG_MAGIC   "ERR64CAT"
+#define ERROR64_CATALOG_VERSION 1
+typedef struct error64_catalog_header { char magic[8]; uint32_t version, nouns, attrs, pool_size; } error64_catalog_header;
+typedef struct error64_catalog error64_catalog;
+// Serialize a catalog into out[cap]. NULL entries are empty strings; attrs may be NULL (keeps built-in attributes).
+// Returns bytes needed (nothing is written if cap is smaller)
+size_t error64_catalog_build( const char *const *nouns, uint32_t num_nouns, const char *const *attrs, uint32_t num_attrs, void *out, size_t cap );
+// Map a catalog file read-only and validate it. Returns NULL if the file cannot be mapped or is not a valid catalog
+error64_catalog *error64_catalog_open( const char *path );
+// Make catalog current (NULL: back to compiled-in names) with an atomic pointer swap. Returns the previous catalog.
+// Threads inside strerror64() keep reading the previous one, so close it only once no thread can be using its strings
+// (e.g. after the next request boundary). Hot reload: old = error64_catalog_swap( error64_catalog_open( path ) )
+error64_catalog *error64_catalog_swap( error64_catalog *catalog );
+// Unmap a catalog that is not current anymore. NULL is ignored
+void error64_catalog_close( error64_catalog *catalog );
+#endif
+
+// Optional message cache (#define ERROR64_CACHE): per-thread, direct-mapped cache of pre-rendered messages keyed by api + descriptor.
+#ifdef ERROR64_CACHE
+#ifndef ERROR64_CACHE_SIZE
+#define ERROR64_CACHE_SIZE 128          // entries per thread (power of two), 64 bytes each
+#endif
+// Message for ec, without a caller buffer. Valid until the next call in this thread. Optional *len receives its length.
+// With ERROR64_PRECOMPUTED_TABLE, built-in messages point into the table instead (always valid, not counted in stats)
+const char *strerror64_cached( int64_t ec, size_t *len );
+// Calling thread's cache hit/miss counters
+void error64_cache_stats( uint64_t *hits, uint64_t *misses );
+#endif
+
+// Optional raise statistics (#define ERROR64_STATS): lock-free, sharded counters per (api, line) site and per descriptor.
+#ifdef ERROR64_STATS
+#ifndef ERROR64_STATS_SHARDS
+#define ERROR64_STATS_SHARDS 8          // threads are spread across shards (power of two)
+#endif
+#ifndef ERROR64_STATS_SLOTS
+#define ERROR64_STATS_SLOTS 512         // distinct sites/descriptors per shard (power of two)
+#endif
+// Keys are codes: sites carry V+L fields, descriptors carry N+A+U fields, so ERROR64_GET_*() and strerror64() work on them
+typedef struct error64_stat { int64_t key; uint64_t count; } error64_stat;
+// Merge all shards. In: capacity of sites[] and descs[]; extra entries are skipped. Out: entries written.
+// Returns raises that were not counted because their shard was full
+uint64_t error64_stats_snapshot( error64_stat *sites, size_t *num_sites, error64_stat *descs, size_t *num_descs );
+#endif
+
+// Optional report sampler (#define ERROR64_SAMPLER): lock-free token buckets keyed by (api, line, descriptor), so a
+// site raising the same error a million times per second is only formatted/logged ERROR64_SAMPLER_BURST times per window.
+// Keys share a direct-mapped table: colliding keys share their budget (suppressing more, never less).
+#ifdef ERROR64_SAMPLER
+#ifndef ERROR64_SAMPLER_SLOTS
+#define ERROR64_SAMPLER_SLOTS 1024      // buckets (power of two), 32 bytes each
+#endif
+#ifndef ERROR64_SAMPLER_BURST
+#define ERROR64_SAMPLER_BURST 8         // reports per key and window
+#endif
+#ifndef ERROR64_SAMPLER_WINDOW_MS
+#define ERROR64_SAMPLER_WINDOW_MS 1000  // window length
+#endif
+typedef struct error64_sample { int64_t code; uint64_t suppressed; } error64_sample;
+// Non-zero if ec should be reported now. Reads a coarse monotonic clock (#define ERROR64_SAMPLER_CLOCK() to provide your own, in ms)
+int error64_should_report( int64_t ec );
+// Same, with the current time in ms (e.g. an event loop's cached time): one atomic add on the hot path
+int error64_should_report_at( int64_t ec, uint64_t now_ms );
+// "N suppressed" summaries: suppressed counts of finished windows, which are reset. Windows that ended without a later
+// raise of their key are closed here, so keys that went quiet after a burst are reported too. Returns entries written
+// to out[cap] (entries that do not fit are kept for the next call)
+size_t error64_sampler_flush( error64_sample *out, size_t cap );
+// Same, with the current time in ms
+size_t error64_sampler_flush_at( error64_sample *out, size_t cap, uint64_t now_ms );
+#endif
+
+// Optional shared-memory board (#define ERROR64_SHM): every raise bumps a per-(api, descriptor) counter and pushes its code into
+// a ring of recent errors, both in a named segment that all processes of a host map, so one reader sees what every worker
+// is failing at without a logging round trip. Lock-free atomics on the mapping; no syscalls on raise.
+// Names: POSIX shared memory ("/error64", link -lrt on old glibc) or Windows named mappings ("Local\\error64").
+// Layout: error64_board_header, error64_board_slot counters[slots], int64_t ring[ring]. The creator picks slots/ring and
+// publishes the header last; processes opening an existing segment wait for it, then validate and adopt its layout once.
+#ifdef ERROR64_SHM
+#include <stdio.h>
+#ifndef ERROR64_SHM_SLOTS
+#define ERROR64_SHM_SLOTS 4096          // distinct (api, descriptor) counters (power of two), 16 bytes each
+#endif
+#ifndef ERROR64_SHM_RING
+#define ERROR64_SHM_RING 1024           // recent codes (power of two), 8 bytes each
+#endif
+#ifndef ERROR64_SHM_MODE
+#define ERROR64_SHM_MODE 0600           // POSIX permissions of new segments (0660 to share with a group)
+#endif
+#define ERROR64_SHM_MAGIC   "ERR64SHM"
+#define ERROR64_SHM_VERSION 1
+typedef struct error64_board_header { char magic[8]; uint32_t version, slots, ring, pad; uint64_t head, dropped; } error64_board_header;
+// Counter keys are codes without rev and line fields (0: empty slot)
+typedef struct error64_board_slot { int64_t key; uint64_t count; } error64_board_slot;
+typedef struct error64_board error64_board;
+// Map segment name, creating it if needed. The first board opened becomes the one raises are recorded into.
+// Returns NULL if the segment cannot be mapped, holds something else, or its creator never finished the header
+error64_board *error64_board_open( const char *name );
+// Unmap a board. Closing the recording board stops recording; do it once no thread raises anymore. NULL is ignored
+void error64_board_close( error64_board *board );
+// Remove segment name (mappings stay valid until closed). Returns 0 on success
+int error64_board_unlink( const char *name );
+// Raises counted for code's api and descriptor, by every process
+uint64_t error64_board_count( const error64_board *board, int64_t code );
+// Copy up to max recent codes, newest first. Returns codes copied
+size_t error64_board_recent( const error64_board *board, int64_t *out, size_t max );
+// Print counters and recent codes (newest first) through strerror64ex(), one per line. Returns lines printed
+size_t error64_board_dump( FILE *fp, const error64_board *board );
+#endif
+
+// Optional asynchronous formatting (#define ERROR64_ASYNC): hot threads only push { code, timestamp, thread id } into a bounded
+// lock-free MPSC queue; a background formatter thread renders batches through strerror64ex() and writes each batch to a
+// file descriptor with one write(). Link -lpthread on POSIX.
+#ifdef ERROR64_ASYNC
+#ifndef ERROR64_ASYNC_QUEUE
+#define ERROR64_ASYNC_QUEUE 4096        // queued codes (power of two), 32 bytes each
+#endif
+#ifndef ERROR64_ASYNC_BATCH
+#define ERROR64_ASYNC_BATCH 256         // codes per write()
+#endif
+#define ERROR64_ASYNC_DROP  0           // full queue: drop the code (counted in metrics)
+#define ERROR64_ASYNC_BLOCK 1           // full queue: wait for the formatter
+#define ERROR64_ASYNC_COUNT 2           // full queue: drop the code, then write a "N codes dropped" line with the next batch
+typedef struct error64_async_stats {
+    uint64_t pushed, dropped, written, batches;     // codes queued, dropped, written; write() calls
+    uint64_t depth, max_depth;                      // queued codes now, and the most seen by the formatter
+    uint64_t latency_avg_ns, latency_max_ns;        // push to write(), through ERROR64_TIMESTAMP()
+} error64_async_stats;
+// Start the formatter thread, writing "<seconds.nanoseconds> T<thread> <strerror64ex>" lines to fd with policy on full queue.
+// Returns 0, or -1 if already running or the thread cannot be created
+int error64_async_start( int fd, int policy );
+// Queue ec for formatting. Returns 1 if queued, 0 if dropped (or not started)
+int error64_async_push( int64_t ec );
+// Write everything queued so far, then stop the formatter thread. Call once producers are done pushing
+void error64_async_stop( void );
+// Metrics since error64_async_start()
+void error64_async_metrics( error64_async_stats *stats );
+#endif
+
+// Optional cause chain (#define ERROR64_CHAIN): every raise pushes the error it replaces (if any) as its cause.
+// Frames live in a per-thread bump arena, reset per request/job with error64_chain_reset(). Nothing is malloc'ed.
+#ifdef ERROR64_CHAIN
+#include <stdio.h>
+#ifndef ERROR64_CHAIN_CAPACITY
+#define ERROR64_CHAIN_CAPACITY 64       // frames per thread; extra causes are not recorded
+#endif
+typedef struct error64_frame { int64_t code; uint64_t timestamp; } error64_frame;
+// Drop all frames of the calling thread
+void error64_chain_reset( void );
+// Calling thread's frames, oldest first: the last frame is the direct cause of the current error. Returns frame count
+size_t error64_chain( const error64_frame **frames );
+// Print ec and its causes (newest first) through strerror64ex(), one per line. Returns frame count
+size_t error64_chain_print( FILE *fp, int64_t ec );
+#endif
+
+// Optional raise traces (#define ERROR64_TRACE): every raise copies up to ERROR64_TRACE_DEPTH raw return addresses into a
+// per-thread ring slot tagged with its code. No symbolization on raise: names are only looked up when a trace is printed.
+// GCC/Clang walk frame pointers within the thread's stack (build with -fno-omit-frame-pointer for fast, complete traces), else
+// fall back to backtrace() or the raise site alone; link -lpthread on old glibc. MSVC uses RtlCaptureStackBackTrace.
+// #define ERROR64_TRACE_CAPTURE(frames, max) to provide your own unwinder (returns frames written).
+#ifdef ERROR64_TRACE
+#include <stdio.h>
+#ifndef ERROR64_TRACE_DEPTH
+#define ERROR64_TRACE_DEPTH 16          // return addresses per raise
+#endif
+#ifndef ERROR64_TRACE_SLOTS
+#define ERROR64_TRACE_SLOTS 32          // traces per thread (power of two); older ones are overwritten
+#endif
+// Calling thread's most recent trace of code, innermost frame (the raise site) first. Returns frames written to frames[max]
+size_t error64_trace( int64_t code, void **frames, size_t max );
+// Print code and its trace through strerror64ex(), symbolized where the platform allows. Returns frames printed
+size_t error64_trace_print( FILE *fp, int64_t code );
+#endif
+
+// Optional site registry (#define ERROR64_SITES): every raise site drops one static record into the error64_sites
+// linker section, so tools can list all errors a binary can raise and map codes back to file/line/function.
+// GCC/Clang (ELF, Mach-O) and MSVC C++ only; other builds compile the records out. Sections are per module (exe/dll).
+// Records are static: GCC/Clang record codes computed at runtime (ERROR64_RAISE(noun | ERR_FULL)) with code 0, as file, line
+// and function only; MSVC needs constant codes at every raise site.
+#if defined(ERROR64_SITES) && ( defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && defined(__cplusplus)) )
+typedef struct error64_site { int64_t code; const char *file; const char *func; uint32_t line, pad; } error64_site;
+// Enumerate all records, sorted by code (code 0 last). The first call sorts the section in place: call at startup, before other threads
+size_t error64_site_list( const error64_site **sites );
+// Binary search a code. Returns NULL if no site raises it as a constant
+const error64_site *error64_site_find( int64_t code );
+#   if defined(__APPLE__)
+#       define ERR_SITES_SECTION "__DATA,error64_sites"
+#   else
+#       define ERR_SITES_SECTION "error64_sites"
+#   endif
+#   if defined(_MSC_VER)
+#       pragma section("error64_sites$m", read, write)
+#       define ERR_SITE(ec) ( [] { __declspec(allocate("error64_sites$m")) static error64_site err_site_ = \
+            { (ec), __FILE__, __FUNCTION__, __LINE__, 0 }; return err_site_.code; }() )
+#   else
+#       define ERR_SITE(ec) __extension__ ({ static error64_site err_site_ \
+            __attribute__((used, section(ERR_SITES_SECTION), aligned(8))) = \
+            { __builtin_constant_p( ec ) ? (ec) : 0, __FILE__, __func__, __LINE__, 0 }; (void)err_site_; (ec); })
+#   endif
+#else
+#   undef ERROR64_SITES
+#   define ERR_SITE(ec) (ec)
+#endif
+// Make an error code and register its site (same as ERROR64() in builds without ERROR64_SITES). Function scope only
+#define ERROR64_SITE(x) ERR_SITE( ERROR64(x) )
+
+// Raise an error: set errno64 and run the opt-in raise hooks (ERROR64_STATS, ERROR64_CHAIN, ERROR64_SHM, ERROR64_TRACE)
+#if defined(ERROR64_STATS) || defined(ERROR64_CHAIN) || defined(ERROR64_SHM) || defined(ERROR64_TRACE)
+#define ERR_RAISE_HOOK(code, cause) error64_raise( code, cause )
+int64_t error64_raise( int64_t code, int64_t cause );
+#else
+#define ERR_RAISE_HOOK(code, cause) (code)
+#endif
+#define ERROR64_RAISE(x) ( errno64 = ERR_RAISE_HOOK( ERROR64_SITE(x), errno64 ) )
+
+// Explicit error context, for callers where thread-local storage is slow or wrong (fibers, coroutines, task schedulers).
+// Carry an error64_ctx along with the task and raise into it instead of errno64.
+typedef struct error64_ctx { int64_t code; } error64_ctx;
+#define ERROR64_CTX_RAISE(ctx, x) ( (ctx)->code = ERR_RAISE_HOOK( ERROR64_SITE(x), (ctx)->code ) )
+
+// Error attributes (Adjetives + Adverbs). X( value, ERR_xxx id, message ) list.
+// This list is the single source of truth for both the ERR_xxx/ERR_NOT_xxx enums and the strerror64() tables.
+// Values are stored in error codes: append new attributes at the end of the list, never reorder.
+#define ERR_ATTRIBUTES(X) \
+    X(   1, A,               "A"              ) \
+    X(   2, ACK,             "ACK"            ) \
+    X(   3, ACTIVE,          "ACTIVE"         ) \
+    X(   4, ALIGNED,         "ALIGNED"        ) \
+    X(   5, ALLOWED,         "ALLOWED"        ) \
+    X(   6, ASSIGNED,        "ASSIGNED"       ) \
+    X(   7, ATTACHED,        "ATTACHED"       ) \
+    X(   8, ATTEMPTED,       "ATTEMPTED"      ) \
+    X(   9, AUTHORIZED,      "AUTHORIZED"     ) \
+    X(  10, AVAILABLE,       "AVAILABLE"      ) \
+    X(  11, BAD,             "BAD"            ) \
+    X(  12, BLOCKED,         "BLOCKED"        ) \
+    X(  13, BROKEN,          "BROKEN"         ) \
+    X(  14, BUILT,           "BUILT"          ) \
+    X(  15, BUSY,            "BUSY"           ) \
+    X(  16, CLOSED,          "CLOSED"         ) \
+    X(  17, COLLIDED,        "COLLIDED"       ) \
+    X(  18, COMPILED,        "COMPILED"       ) \
+    X(  19, COMPLETE,        "COMPLETE"       ) \
+    X(  20, CONFLICTED,      "CONFLICTED"     ) \
+    X(  21, CONNECTED,       "CONNECTED"      ) \
+    X(  22, CONSTRUCTED,     "CONSTRUCTED"    ) \
+    X(  23, CREATED,         "CREATED"        ) \
+    X(  24, DEFINED,         "DEFINED"        ) \
+    X(  25, DENIED,          "DENIED"         ) \
+    X(  26, DEPARTED,        "DEPARTED"       ) \
+    X(  27, DESTRUCTED,      "DESTRUCTED"     ) \
+    X(  28, DETACHED,        "DETACHED"       ) \
+    X(  29, DETECTED,        "DETECTED"       ) \
+    X(  30, DISABLED,        "DISABLED"       ) \
+    X(  31, DOWN,            "DOWN"           ) \
+    X(  32, DOWNLOADED,      "DOWNLOADED"     ) \
+    X(  33, EMPTY,           "EMPTY"          ) \
+    X(  34, ENABLED,         "ENABLED"        ) \
+    X(  35, ENHANCED,        "ENHANCED"       ) \
+    X(  36, ENOUGH,          "ENOUGH"         ) \
+    X(  37, EXCEEDED,        "EXCEEDED"       ) \
+    X(  38, EXCHANGED,       "EXCHANGED"      ) \
+    X(  39, EXECUTABLE,      "EXECUTABLE"     ) \
+    X(  40, EXISTS,          "EXISTS"         ) \
+    X(  41, EXPIRED,         "EXPIRED"        ) \
+    X(  42, EXTENDED,        "EXTENDED"       ) \
+    X(  43, FAILED,          "FAILED"         ) \
+    X(  44, FALSE,           "FALSE"          ) \
+    X(  45, FATAL,           "FATAL"          ) \
+    X(  46, FORBIDDEN,       "FORBIDDEN"      ) \
+    X(  47, FORMATTED,       "FORMATTED"      ) \
+    X(  48, FOUND,           "FOUND"          ) \
+    X(  49, FULL,            "FULL"           ) \
+    X(  50, GONE,            "GONE"           ) \
+    X(  51, GOOD,            "GOOD"           ) \
+    X(  52, HALTED,          "HALTED"         ) \
+    X(  53, HIDDEN,          "HIDDEN"         ) \
+    X(  54, HOLD,            "HOLD"           ) \
+    X(  55, IDLE,            "IDLE"           ) \
+    X(  56, ILLEGAL,         "ILLEGAL"        ) \
+    X(  57, IMPLEMENTED,     "IMPLEMENTED"    ) \
+    X(  58, IN_PROGRESS,     "IN PROGRESS"    ) \
+    X(  59, IN_USE,          "IN USE"         ) \
+    X(  60, INITIALIZED,     "INITIALIZED"    ) \
+    X(  61, INSERTED,        "INSERTED"       ) \
+    X(  62, INSTALLED,       "INSTALLED"      ) \
+    X(  63, INTERRUPTED,     "INTERRUPTED"    ) \
+    X(  64, JOINED,          "JOINED"         ) \
+    X(  65, KNOWN,           "KNOWN"          ) \
+    X(  66, LINKED,          "LINKED"         ) \
+    X(  67, LOADED,          "LOADED"         ) \
+    X(  68, LOCAL,           "LOCAL"          ) \
+    X(  69, LOCKED,          "LOCKED"         ) \
+    X(  70, LOOPED,          "LOOPED"         ) \
+    X(  71, LOST,            "LOST"           ) \
+    X(  72, MERGED,          "MERGED"         ) \
+    X(  73, MISSING,         "MISSING"        ) \
+    X(  74, MOUNTED,         "MOUNTED"        ) \
+    X(  75, NEEDED,          "NEEDED"         ) \
+    X(  76, NO,              "NO"             ) \
+    X(  77, NO_SUCH,         "NO SUCH"        ) \
+    X(  78, OFF,             "OFF"            ) \
+    X(  79, ON,              "ON"             ) \
+    X(  80, ONLINE,          "ONLINE"         ) \
+    X(  81, OPEN,            "OPEN"           ) \
+    X(  82, ORDERED,         "ORDERED"        ) \
+    X(  83, OUT_OF,          "OUT OF"         ) \
+    X(  84, OUT_OF_RANGE,    "OUT OF RANGE"   ) \
+    X(  85, OVERFLOW,        "OVERFLOW"       ) \
+    X(  86, PADDED,          "PADDED"         ) \
+    X(  87, PARTED,          "PARTED"         ) \
+    X(  88, PERMITTED,       "PERMITTED"      ) \
+    X(  89, POPPED,          "POPPED"         ) \
+    X(  90, PRELOADED,       "PRELOADED"      ) \
+    X(  91, PROCESSABLE,     "PROCESSABLE"    ) \
+    X(  92, PROVIDED,        "PROVIDED"       ) \
+    X(  93, PUSHED,          "PUSHED"         ) \
+    X(  94, REACHABLE,       "REACHABLE"      ) \
+    X(  95, READABLE,        "READABLE"       ) \
+    X(  96, RECEIVED,        "RECEIVED"       ) \
+    X(  97, REFUSED,         "REFUSED"        ) \
+    X(  98, REGISTERED,      "REGISTERED"     ) \
+    X(  99, REJECTED,        "REJECTED"       ) \
+    X( 100, RELEASED,        "RELEASED"       ) \
+    X( 101, REMOTE,          "REMOTE"         ) \
+    X( 102, REMOVED,         "REMOVED"        ) \
+    X( 103, RENDERABLE,      "RENDERABLE"     ) \
+    X( 104, RESERVED,        "RESERVED"       ) \
+    X( 105, RESET,           "RESET"          ) \
+    X( 106, RESPONDING,      "RESPONDING"     ) \
+    X( 107, RETRIED,         "RETRIED"        ) \
+    X( 108, RIGHT,           "RIGHT"          ) \
+    X( 109, RUNNING,         "RUNNING"        ) \
+    X( 110, SENT,            "SENT"           ) \
+    X( 111, SHARED,          "SHARED"         ) \
+    X( 112, SORTED,          "SORTED"         ) \
+    X( 113, SPECIFIED,       "SPECIFIED"      ) \
+    X( 114, SPLITTED,        "SPLITTED"       ) \
+    X( 115, STALLED,         "STALLED"        ) \
+    X( 116, STOPPED,         "STOPPED"        ) \
+    X( 117, SUCEEDED,        "SUCEEDED"       ) \
+    X( 118, SUITABLE,        "SUITABLE"       ) \
+    X( 119, SUPPORTED,       "SUPPORTED"      ) \
+    X( 120, SYNCHRONIZED,    "SYNCHRONIZED"   ) \
+    X( 121, TERMINATED,      "TERMINATED"     ) \
+    X( 122, THROWN,          "THROWN"         ) \
+    X( 123, TIMED_OUT,       "TIMED OUT"      ) \
+    X( 124, TOO_COMPLEX,     "TOO COMPLEX"    ) \
+    X( 125, TOO_FEW,         "TOO FEW"        ) \
+    X( 126, TOO_LARGE,       "TOO LARGE"      ) \
+    X( 127, TOO_LONG,        "TOO LONG"       ) \
+    X( 128, TOO_MANY,        "TOO MANY"       ) \
+    X( 129, TOO_MUCH,        "TOO MUCH"       ) \
+    X( 130, TOO_SIMPLE,      "TOO SIMPLE"     ) \
+    X( 131, TOO_SMALL,       "TOO SMALL"      ) \
+    X( 132, TRIGGERED,       "TRIGGERED"      ) \
+    X( 133, TRUE,            "TRUE"           ) \
+    X( 134, UNBLOCKED,       "UNBLOCKED"      ) \
+    X( 135, UNDERFLOW,       "UNDERFLOW"      ) \
+    X( 136, UNINITIALIZED,   "UNINITIALIZED"  ) \
+    X( 137, UNINSTALLED,     "UNINSTALLED"    ) \
+    X( 138, UNIQUE,          "UNIQUE"         ) \
+    X( 139, UNLOADED,        "UNLOADED"       ) \
+    X( 140, UNLOCKED,        "UNLOCKED"       ) \
+    X( 141, UNSORTED,        "UNSORTED"       ) \
+    X( 142, UP,              "UP"             ) \
+    X( 143, UPDATED,         "UPDATED"        ) \
+    X( 144, UPGRADED,        "UPGRADED"       ) \
+    X( 145, UPLOADED,        "UPLOADED"       ) \
+    X( 146, USED,            "USED"           ) \
+    X( 147, VALID,           "VALID"          ) \
+    X( 148, VISIBLE,         "VISIBLE"        ) \
+    X( 149, WORKING,         "WORKING"        ) \
+    X( 150, WRITABLE,        "WRITABLE"       ) \
+    X( 151, WRONG,           "WRONG"          )
 
 // Error attribute aliases
 #define ERR_UNDEFINED (ERR_NOT_DEFINED)
@@ -406,656 +659,2956 @@ extern ERR_TLS(int64_t) errno64;
 #define ERR_ERROR                       ( 1LL << ERR_BIT_E ) /*Error-bit*/
 #define ERR_NOT                         ( 1LL << ERR_BIT_N ) /*Negate-bit*/
 
+// Error attributes (1LL << YY) and their negate forms (ERR_NOT | ERR_xxx)
+// C++ gets 64-bit constants so that mixing them with NN_xxx enums never is an enum-enum bitwise operation
+#ifdef __cplusplus
+#define ERR_ENUM(n, id, str) static const int64_t ERR_##id = ( n##LL << ERR_BIT_A ), ERR_NOT_##id = ( ERR_NOT | ERR_##id );
+ERR_ATTRIBUTES(ERR_ENUM)
+#else
+#define ERR_ENUM(n, id, str) ERR_##id = ( n << ERR_BIT_A ), ERR_NOT_##id = ( ERR_NOT | ERR_##id ),
+enum { ERR_ATTRIBUTES(ERR_ENUM) };
+#endif
+#undef ERR_ENUM
+
 // Make helpers
 #define ERR_jN(a,b) a##b
 #define ERR_JN(a,b) ERR_jN(a,b)
 
 #ifndef ERROR64_USER_DEFINED_GLOSSARY
 // Glossary: A few app/user-defined nouns for an imaginary game engine
-// The following enum plus the attributes above makes a total of 30300 different messages.
-enum {
-    NN_BLANK,
-
-    NN_ACCESS,
-    NN_ACCOUNT,
-    NN_ADDRESS,
-    NN_ADMINISTRATOR,
-    NN_API,
-    NN_APPLICATION,
-    NN_ARCHIVE,
-    NN_ARGUMENT,
-    NN_ASSET,
-    NN_AUDIO,
-    NN_AUTHENTICATION,
-    NN_BINARY,
-    NN_BIRTHDATE,
-    NN_BLOB,
-    NN_BOX,
-    NN_BROADCAST,
-    NN_CAPSULE,
-    NN_CHECKBOX,
-    NN_CINEMATIC,
-    NN_CIRCLE,
-    NN_CLASS,
-    NN_CLIENT,
-    NN_CLOUD,
-    NN_CODE,
-    NN_COMBO,
-    NN_COMMIT,
-    NN_COMPILATION,
-    NN_COMPILER,
-    NN_COMPRESSION,
-    NN_CONSOLE,
-    NN_CONTROLLER,
-    NN_COUNTRY,
-    NN_CVS,
-    NN_CYPHERING,
-    NN_DAEMON,
-    NN_DATA,
-    NN_DEPENDENCY,
-    NN_DESCRIPTOR,
-    NN_DEVICE,
-    NN_DIAGRAM,
-    NN_DIRECTORY,
-    NN_DISK,
-    NN_DLL,
-    NN_DOMAIN,
-    NN_DOWNLOAD,
-    NN_DRIVER,
-    NN_EDITOR,
-    NN_ENDPOINT,
-    NN_ENGINE,
-    NN_EVALUATION,
-    NN_EVALUATOR,
-    NN_EVENT,
-    NN_EXCEPTION,
-    NN_EXCHANGE,
-    NN_EXPECTATION,
-    NN_FETCH,
-    NN_FILE,
-    NN_FLOAT,
-    NN_FLOW,
-    NN_FOLDER,
-    NN_FONT,
-    NN_FORMAT,
-    NN_FUNCTION,
-    NN_GAME,
-    NN_GAMEPAD,
-    NN_GATEWAY,
-    NN_GEOMETRY,
-    NN_GIZMO,
-    NN_GRAPH,
-    NN_GRAPHICS,
-    NN_GROUP,
-    NN_HANDLE,
-    NN_HARDWARE,
-    NN_HEADER,
-    NN_HID,
-    NN_HMD,
-    NN_HOST,
-    NN_IDENTIFIER,
-    NN_INDEX,
-    NN_INPUT,
-    NN_INTEGER,
-    NN_INTERFACE,
-    NN_INTERVAL,
-    NN_IO,
-    NN_JOYSTICK,
-    NN_KEYBOARD,
-    NN_LENGTH,
-    NN_LEVEL,
-    NN_LIBRARY,
-    NN_LIMIT,
-    NN_LINK,
-    NN_LINKAGE,
-    NN_LINKER,
-    NN_LOCATION,
-    NN_LOGIN,
-    NN_LOOP,
-    NN_MACHINE,
-    NN_MEDIA,
-    NN_MEMORY,
-    NN_MESH,
-    NN_MESSAGE,
-    NN_METHOD,
-    NN_MODEL,
-    NN_MODULE,
-    NN_MONITOR,
-    NN_MOUSE,
-    NN_NETWORK,
-    NN_NICKNAME,
-    NN_NODE,
-    NN_NOTHING,
-    NN_NUMBER,
-    NN_OBJECT,
-    NN_OPERATION,
-    NN_OPERATOR,
-    NN_ORIENTATION,
-    NN_PACKAGE,
-    NN_PASSWORD,
-    NN_PATH,
-    NN_PATHFILE,
-    NN_PAYMENT,
-    NN_PAYWALL,
-    NN_PEER,
-    NN_PERMISSION,
-    NN_PHYSICS,
-    NN_PLATFORM,
-    NN_PLUGIN,
-    NN_POSITION,
-    NN_POSTCONDITION,
-    NN_PRECONDITION,
-    NN_PROFILER,
-    NN_PROTOCOL,
-    NN_PROXY,
-    NN_QUERY,
-    NN_RANGE,
-    NN_RATIO,
-    NN_RECORD,
-    NN_RENDERER,
-    NN_REPOSITORY,
-    NN_REQUEST,
-    NN_RESOURCE,
-    NN_REVISION,
-    NN_ROTATION,
-    NN_ROUTE,
-    NN_RUNTIME,
-    NN_SCALE,
-    NN_SCREEN,
-    NN_SCRIPT,
-    NN_SEARCH,
-    NN_SEQUENCE,
-    NN_SERIALIZATION,
-    NN_SERVER,
-    NN_SERVICE,
-    NN_SHADER,
-    NN_SHAPE,
-    NN_SIZE,
-    NN_SLIDER,
-    NN_SOFTWARE,
-    NN_SOURCE,
-    NN_SPACE,
-    NN_SPHERE,
-    NN_SQUARE,
-    NN_STACK,
-    NN_STACKTRACE,
-    NN_STAGE,
-    NN_STARTPOINT,
-    NN_STREAM,
-    NN_STREAMING,
-    NN_STRING,
-    NN_STRUCT,
-    NN_SUBSYSTEM,
-    NN_SYMBOL,
-    NN_SYSTEM,
-    NN_TEXT,
-    NN_TIME,
-    NN_TOUCH,
-    NN_TRANSFORM,
-    NN_TRANSLATION,
-    NN_TRANSPORT,
-    NN_TRIGGER,
-    NN_TRUETYPE,
-    NN_TYPE,
-    NN_UPGRADE,
-    NN_UPLOAD,
-    NN_USER,
-    NN_USERNAME,
-    NN_VALUE,
-    NN_VARIANT,
-    NN_VERSION,
-    NN_VISUALIZER,
-    NN_WEBPAGE,
-    NN_WEBSITE,
-    NN_WEBVIEW,
-    NN_WIDGET,
-    NN_WINDOW,
-    NN_ZIPCODE,
-};
+// The following X( NN_xxx id, noun ) list plus the attributes above makes a total of 30300 different messages.
+// Values are stored in error codes: append new nouns at the end of the list, never reorder.
+#define ERR_NOUNS(X) \
+    X( ACCESS,         "ACCESS" ) \
+    X( ACCOUNT,        "ACCOUNT" ) \
+    X( ADDRESS,        "ADDRESS" ) \
+    X( ADMINISTRATOR,  "ADMINISTRATOR" ) \
+    X( API,            "API" ) \
+    X( APPLICATION,    "APPLICATION" ) \
+    X( ARCHIVE,        "ARCHIVE" ) \
+    X( ARGUMENT,       "ARGUMENT" ) \
+    X( ASSET,          "ASSET" ) \
+    X( AUDIO,          "AUDIO" ) \
+    X( AUTHENTICATION, "AUTHENTICATION" ) \
+    X( BINARY,         "BINARY" ) \
+    X( BIRTHDATE,      "BIRTHDATE" ) \
+    X( BLOB,           "BLOB" ) \
+    X( BOX,            "BOX" ) \
+    X( BROADCAST,      "BROADCAST" ) \
+    X( CAPSULE,        "CAPSULE" ) \
+    X( CHECKBOX,       "CHECKBOX" ) \
+    X( CINEMATIC,      "CINEMATIC" ) \
+    X( CIRCLE,         "CIRCLE" ) \
+    X( CLASS,          "CLASS" ) \
+    X( CLIENT,         "CLIENT" ) \
+    X( CLOUD,          "CLOUD" ) \
+    X( CODE,           "CODE" ) \
+    X( COMBO,          "COMBO" ) \
+    X( COMMIT,         "COMMIT" ) \
+    X( COMPILATION,    "COMPILATION" ) \
+    X( COMPILER,       "COMPILER" ) \
+    X( COMPRESSION,    "COMPRESSION" ) \
+    X( CONSOLE,        "CONSOLE" ) \
+    X( CONTROLLER,     "CONTROLLER" ) \
+    X( COUNTRY,        "COUNTRY" ) \
+    X( CVS,            "CVS" ) \
+    X( CYPHERING,      "CYPHERING" ) \
+    X( DAEMON,         "DAEMON" ) \
+    X( DATA,           "DATA" ) \
+    X( DEPENDENCY,     "DEPENDENCY" ) \
+    X( DESCRIPTOR,     "DESCRIPTOR" ) \
+    X( DEVICE,         "DEVICE" ) \
+    X( DIAGRAM,        "DIAGRAM" ) \
+    X( DIRECTORY,      "DIRECTORY" ) \
+    X( DISK,           "DISK" ) \
+    X( DLL,            "DLL" ) \
+    X( DOMAIN,         "DOMAIN" ) \
+    X( DOWNLOAD,       "DOWNLOAD" ) \
+    X( DRIVER,         "DRIVER" ) \
+    X( EDITOR,         "EDITOR" ) \
+    X( ENDPOINT,       "ENDPOINT" ) \
+    X( ENGINE,         "ENGINE" ) \
+    X( EVALUATION,     "EVALUATION" ) \
+    X( EVALUATOR,      "EVALUATOR" ) \
+    X( EVENT,          "EVENT" ) \
+    X( EXCEPTION,      "EXCEPTION" ) \
+    X( EXCHANGE,       "EXCHANGE" ) \
+    X( EXPECTATION,    "EXPECTATION" ) \
+    X( FETCH,          "FETCH" ) \
+    X( FILE,           "FILE" ) \
+    X( FLOAT,          "FLOAT" ) \
+    X( FLOW,           "FLOW" ) \
+    X( FOLDER,         "FOLDER" ) \
+    X( FONT,           "FONT" ) \
+    X( FORMAT,         "FORMAT" ) \
+    X( FUNCTION,       "FUNCTION" ) \
+    X( GAME,           "GAME" ) \
+    X( GAMEPAD,        "GAMEPAD" ) \
+    X( GATEWAY,        "GATEWAY" ) \
+    X( GEOMETRY,       "GEOMETRY" ) \
+    X( GIZMO,          "GIZMO" ) \
+    X( GRAPH,          "GRAPH" ) \
+    X( GRAPHICS,       "GRAPHICS" ) \
+    X( GROUP,          "GROUP" ) \
+    X( HANDLE,         "HANDLE" ) \
+    X( HARDWARE,       "HARDWARE" ) \
+    X( HEADER,         "HEADER" ) \
+    X( HID,            "HID" ) \
+    X( HMD,            "HMD" ) \
+    X( HOST,           "HOST" ) \
+    X( IDENTIFIER,     "IDENTIFIER" ) \
+    X( INDEX,          "INDEX" ) \
+    X( INPUT,          "INPUT" ) \
+    X( INTEGER,        "INTEGER" ) \
+    X( INTERFACE,      "INTERFACE" ) \
+    X( INTERVAL,       "INTERVAL" ) \
+    X( IO,             "IO" ) \
+    X( JOYSTICK,       "JOYSTICK" ) \
+    X( KEYBOARD,       "KEYBOARD" ) \
+    X( LENGTH,         "LENGTH" ) \
+    X( LEVEL,          "LEVEL" ) \
+    X( LIBRARY,        "LIBRARY" ) \
+    X( LIMIT,          "LIMIT" ) \
+    X( LINK,           "LINK" ) \
+    X( LINKAGE,        "LINKAGE" ) \
+    X( LINKER,         "LINKER" ) \
+    X( LOCATION,       "LOCATION" ) \
+    X( LOGIN,          "LOGIN" ) \
+    X( LOOP,           "LOOP" ) \
+    X( MACHINE,        "MACHINE" ) \
+    X( MEDIA,          "MEDIA" ) \
+    X( MEMORY,         "MEMORY" ) \
+    X( MESH,           "MESH" ) \
+    X( MESSAGE,        "MESSAGE" ) \
+    X( METHOD,         "METHOD" ) \
+    X( MODEL,          "MODEL" ) \
+    X( MODULE,         "MODULE" ) \
+    X( MONITOR,        "MONITOR" ) \
+    X( MOUSE,          "MOUSE" ) \
+    X( NETWORK,        "NETWORK" ) \
+    X( NICKNAME,       "NICKNAME" ) \
+    X( NODE,           "NODE" ) \
+    X( NOTHING,        "NOTHING" ) \
+    X( NUMBER,         "NUMBER" ) \
+    X( OBJECT,         "OBJECT" ) \
+    X( OPERATION,      "OPERATION" ) \
+    X( OPERATOR,       "OPERATOR" ) \
+    X( ORIENTATION,    "ORIENTATION" ) \
+    X( PACKAGE,        "PACKAGE" ) \
+    X( PASSWORD,       "PASSWORD" ) \
+    X( PATH,           "PATH" ) \
+    X( PATHFILE,       "PATHFILE" ) \
+    X( PAYMENT,        "PAYMENT" ) \
+    X( PAYWALL,        "PAYWALL" ) \
+    X( PEER,           "PEER" ) \
+    X( PERMISSION,     "PERMISSION" ) \
+    X( PHYSICS,        "PHYSICS" ) \
+    X( PLATFORM,       "PLATFORM" ) \
+    X( PLUGIN,         "PLUGIN" ) \
+    X( POSITION,       "POSITION" ) \
+    X( POSTCONDITION,  "POSTCONDITION" ) \
+    X( PRECONDITION,   "PRECONDITION" ) \
+    X( PROFILER,       "PROFILER" ) \
+    X( PROTOCOL,       "PROTOCOL" ) \
+    X( PROXY,          "PROXY" ) \
+    X( QUERY,          "QUERY" ) \
+    X( RANGE,          "RANGE" ) \
+    X( RATIO,          "RATIO" ) \
+    X( RECORD,         "RECORD" ) \
+    X( RENDERER,       "RENDERER" ) \
+    X( REPOSITORY,     "REPOSITORY" ) \
+    X( REQUEST,        "REQUEST" ) \
+    X( RESOURCE,       "RESOURCE" ) \
+    X( REVISION,       "REVISION" ) \
+    X( ROTATION,       "ROTATION" ) \
+    X( ROUTE,          "ROUTE" ) \
+    X( RUNTIME,        "RUNTIME" ) \
+    X( SCALE,          "SCALE" ) \
+    X( SCREEN,         "SCREEN" ) \
+    X( SCRIPT,         "SCRIPT" ) \
+    X( SEARCH,         "SEARCH" ) \
+    X( SEQUENCE,       "SEQUENCE" ) \
+    X( SERIALIZATION,  "SERIALIZATION" ) \
+    X( SERVER,         "SERVER" ) \
+    X( SERVICE,        "SERVICE" ) \
+    X( SHADER,         "SHADER" ) \
+    X( SHAPE,          "SHAPE" ) \
+    X( SIZE,           "SIZE" ) \
+    X( SLIDER,         "SLIDER" ) \
+    X( SOFTWARE,       "SOFTWARE" ) \
+    X( SOURCE,         "SOURCE" ) \
+    X( SPACE,          "SPACE" ) \
+    X( SPHERE,         "SPHERE" ) \
+    X( SQUARE,         "SQUARE" ) \
+    X( STACK,          "STACK" ) \
+    X( STACKTRACE,     "STACKTRACE" ) \
+    X( STAGE,          "STAGE" ) \
+    X( STARTPOINT,     "STARTPOINT" ) \
+    X( STREAM,         "STREAM" ) \
+    X( STREAMING,      "STREAMING" ) \
+    X( STRING,         "STRING" ) \
+    X( STRUCT,         "STRUCT" ) \
+    X( SUBSYSTEM,      "SUBSYSTEM" ) \
+    X( SYMBOL,         "SYMBOL" ) \
+    X( SYSTEM,         "SYSTEM" ) \
+    X( TEXT,           "TEXT" ) \
+    X( TIME,           "TIME" ) \
+    X( TOUCH,          "TOUCH" ) \
+    X( TRANSFORM,      "TRANSFORM" ) \
+    X( TRANSLATION,    "TRANSLATION" ) \
+    X( TRANSPORT,      "TRANSPORT" ) \
+    X( TRIGGER,        "TRIGGER" ) \
+    X( TRUETYPE,       "TRUETYPE" ) \
+    X( TYPE,           "TYPE" ) \
+    X( UPGRADE,        "UPGRADE" ) \
+    X( UPLOAD,         "UPLOAD" ) \
+    X( USER,           "USER" ) \
+    X( USERNAME,       "USERNAME" ) \
+    X( VALUE,          "VALUE" ) \
+    X( VARIANT,        "VARIANT" ) \
+    X( VERSION,        "VERSION" ) \
+    X( VISUALIZER,     "VISUALIZER" ) \
+    X( WEBPAGE,        "WEBPAGE" ) \
+    X( WEBSITE,        "WEBSITE" ) \
+    X( WEBVIEW,        "WEBVIEW" ) \
+    X( WIDGET,         "WIDGET" ) \
+    X( WINDOW,         "WINDOW" ) \
+    X( ZIPCODE,        "ZIPCODE" )
+
+#define ERR_ENUM(id, str) NN_##id,
+enum { NN_BLANK, ERR_NOUNS(ERR_ENUM) };
+#undef ERR_ENUM
 #endif
 
 #ifdef ERROR64_DEFINE_IMPLEMENTATION
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 // App/user defined glossary (provided by app/user/library)
 const char *glossary( int enumeration );
 
 // Thread-local storage errno64 variable
-ERR_TLS(int64_t) errno64 = 0;
+#ifndef ERROR64_TASK_LOCAL
+ERR_TLS(int64_t) errno64 ERR_TLS_MODEL = 0;
+#else
+static ERR_TLS(int64_t) err_errno64 ERR_TLS_MODEL = 0;
+static int64_t *err_thread_location( void ) {
+    return &err_errno64;
+}
+static error64_location_fn err_location = err_thread_location;
 
-// Print error to a [256] char buffer
-const char *strerror64( char buf256[256], int64_t errno64 ) {
-    if( errno64 >= 0 ) return (buf256[0] = '\0', buf256);
-    const char *neg = "", *adj = "";
-    char noun[256-48];
-    strcpy( noun, glossary(errno64 & 0x7fff) );
-    if( errno64 & ( 1LL << ERR_BIT_N ) ) {
-        neg = "NOT";
-    }
-    switch( errno64 & ( 0xffLL << ERR_BIT_A ) ) {
-        default:
-        break; case ERR_A: adj = "A";
-        break; case ERR_ACK: adj = "ACK";
-        break; case ERR_ACTIVE: adj = "ACTIVE";
-        break; case ERR_ALIGNED: adj = "ALIGNED";
-        break; case ERR_ALLOWED: adj = "ALLOWED";
-        break; case ERR_ASSIGNED: adj = "ASSIGNED";
-        break; case ERR_ATTACHED: adj = "ATTACHED";
-        break; case ERR_ATTEMPTED: adj = "ATTEMPTED";
-        break; case ERR_AUTHORIZED: adj = "AUTHORIZED";
-        break; case ERR_AVAILABLE: adj = "AVAILABLE";
-        break; case ERR_BAD: adj = "BAD";
-        break; case ERR_BLOCKED: adj = "BLOCKED";
-        break; case ERR_BROKEN: adj = "BROKEN";
-        break; case ERR_BUILT: adj = "BUILT";
-        break; case ERR_BUSY: adj = "BUSY";
-        break; case ERR_CLOSED: adj = "CLOSED";
-        break; case ERR_COMPILED: adj = "COMPILED";
-        break; case ERR_COMPLETE: adj = "COMPLETE";
-        break; case ERR_CONFLICTED: adj = "CONFLICTED";
-        break; case ERR_CONNECTED: adj = "CONNECTED";
-        break; case ERR_CONSTRUCTED: adj = "CONSTRUCTED";
-        break; case ERR_CREATED: adj = "CREATED";
-        break; case ERR_DEFINED: adj = "DEFINED";
-        break; case ERR_DENIED: adj = "DENIED";
-        break; case ERR_DESTRUCTED: adj = "DESTRUCTED";
-        break; case ERR_DETACHED: adj = "DETACHED";
-        break; case ERR_DETECTED: adj = "DETECTED";
-        break; case ERR_DOWN: adj = "DOWN";
-        break; case ERR_DOWNLOADED: adj = "DOWNLOADED";
-        break; case ERR_EMPTY: adj = "EMPTY";
-        break; case ERR_ENHANCED: adj = "ENHANCED";
-        break; case ERR_ENOUGH: adj = "ENOUGH";
-        break; case ERR_EXCEEDED: adj = "EXCEEDED";
-        break; case ERR_EXCHANGED: adj = "EXCHANGED";
-        break; case ERR_EXECUTABLE: adj = "EXECUTABLE";
-        break; case ERR_EXISTS: adj = "EXISTS";
-        break; case ERR_EXPIRED: adj = "EXPIRED";
-        break; case ERR_EXTENDED: adj = "EXTENDED";
-        break; case ERR_FAILED: adj = "FAILED";
-        break; case ERR_FALSE: adj = "FALSE";
-        break; case ERR_FATAL: adj = "FATAL";
-        break; case ERR_FORBIDDEN: adj = "FORBIDDEN";
-        break; case ERR_FORMATTED: adj = "FORMATTED";
-        break; case ERR_FOUND: adj = "FOUND";
-        break; case ERR_FULL: adj = "FULL";
-        break; case ERR_GONE: adj = "GONE";
-        break; case ERR_GOOD: adj = "GOOD";
-        break; case ERR_HALTED: adj = "HALTED";
-        break; case ERR_HOLD: adj = "HOLD";
-        break; case ERR_IDLE: adj = "IDLE";
-        break; case ERR_ILLEGAL: adj = "ILLEGAL";
-        break; case ERR_IMPLEMENTED: adj = "IMPLEMENTED";
-        break; case ERR_IN_PROGRESS: adj = "IN PROGRESS";
-        break; case ERR_IN_USE: adj = "IN USE";
-        break; case ERR_INITIALIZED: adj = "INITIALIZED";
-        break; case ERR_INSTALLED: adj = "INSTALLED";
-        break; case ERR_INTERRUPTED: adj = "INTERRUPTED";
-        break; case ERR_KNOWN: adj = "KNOWN";
-        break; case ERR_LINKED: adj = "LINKED";
-        break; case ERR_LOADED: adj = "LOADED";
-        break; case ERR_LOCAL: adj = "LOCAL";
-        break; case ERR_LOCKED: adj = "LOCKED";
-        break; case ERR_LOOPED: adj = "LOOPED";
-        break; case ERR_LOST: adj = "LOST";
-        break; case ERR_MISSING: adj = "MISSING";
-        break; case ERR_MOUNTED: adj = "MOUNTED";
-        break; case ERR_NEEDED: adj = "NEEDED";
-        break; case ERR_NO: adj = "NO";
-        break; case ERR_NO_SUCH: adj = "NO SUCH";
-        break; case ERR_OFF: adj = "OFF";
-        break; case ERR_ON: adj = "ON";
-        break; case ERR_ONLINE: adj = "ONLINE";
-        break; case ERR_OPEN: adj = "OPEN";
-        break; case ERR_ORDERED: adj = "ORDERED";
-        break; case ERR_OUT_OF: adj = "OUT OF";
-        break; case ERR_OUT_OF_RANGE: adj = "OUT OF RANGE";
-        break; case ERR_OVERFLOW: adj = "OVERFLOW";
-        break; case ERR_PADDED: adj = "PADDED";
-        break; case ERR_PERMITTED: adj = "PERMITTED";
-        break; case ERR_PROCESSABLE: adj = "PROCESSABLE";
-        break; case ERR_PROVIDED: adj = "PROVIDED";
-        break; case ERR_REACHABLE: adj = "REACHABLE";
-        break; case ERR_READABLE: adj = "READABLE";
-        break; case ERR_RECEIVED: adj = "RECEIVED";
-        break; case ERR_REFUSED: adj = "REFUSED";
-        break; case ERR_REGISTERED: adj = "REGISTERED";
-        break; case ERR_REJECTED: adj = "REJECTED";
-        break; case ERR_RELEASED: adj = "RELEASED";
-        break; case ERR_REMOTE: adj = "REMOTE";
-        break; case ERR_RENDERABLE: adj = "RENDERABLE";
-        break; case ERR_RESERVED: adj = "RESERVED";
-        break; case ERR_RESET: adj = "RESET";
-        break; case ERR_RESPONDING: adj = "RESPONDING";
-        break; case ERR_RETRIED: adj = "RETRIED";
-        break; case ERR_RIGHT: adj = "RIGHT";
-        break; case ERR_RUNNING: adj = "RUNNING";
-        break; case ERR_SENT: adj = "SENT";
-        break; case ERR_SPECIFIED: adj = "SPECIFIED";
-        break; case ERR_STALLED: adj = "STALLED";
-        break; case ERR_STOPPED: adj = "STOPPED";
-        break; case ERR_SUCEEDED: adj = "SUCEEDED";
-        break; case ERR_SUITABLE: adj = "SUITABLE";
-        break; case ERR_SUPPORTED: adj = "SUPPORTED";
-        break; case ERR_SYNCHRONIZED: adj = "SYNCHRONIZED";
-        break; case ERR_TERMINATED: adj = "TERMINATED";
-        break; case ERR_THROWN: adj = "THROWN";
-        break; case ERR_TIMED_OUT: adj = "TIMED OUT";
-        break; case ERR_TOO_COMPLEX: adj = "TOO COMPLEX";
-        break; case ERR_TOO_FEW: adj = "TOO FEW";
-        break; case ERR_TOO_LARGE: adj = "TOO LARGE";
-        break; case ERR_TOO_LONG: adj = "TOO LONG";
-        break; case ERR_TOO_MANY: adj = "TOO MANY";
-        break; case ERR_TOO_MUCH: adj = "TOO MUCH";
-        break; case ERR_TOO_SIMPLE: adj = "TOO SIMPLE";
-        break; case ERR_TOO_SMALL: adj = "TOO SMALL";
-        break; case ERR_TRIGGERED: adj = "TRIGGERED";
-        break; case ERR_TRUE: adj = "TRUE";
-        break; case ERR_UNIQUE: adj = "UNIQUE";
-        break; case ERR_UP: adj = "UP";
-        break; case ERR_UPDATED: adj = "UPDATED";
-        break; case ERR_UPGRADED: adj = "UPGRADED";
-        break; case ERR_UPLOADED: adj = "UPLOADED";
-        break; case ERR_USED: adj = "USED";
-        break; case ERR_VALID: adj = "VALID";
-        break; case ERR_WORKING: adj = "WORKING";
-        break; case ERR_WRITABLE: adj = "WRITABLE";
-        break; case ERR_WRONG: adj = "WRONG";
-    };
-    const char *common[] = { noun, neg, adj }, *special[] = { neg, adj, noun }, **use = common;
-    int64_t type = errno64 & (0x1ffLL << ERR_BIT_A);
-    if( (type == ERR_A)  || (type == ERR_NOT_A) ||
-        (type == ERR_NO) || (type == ERR_NO_SUCH) ||
-        (type == ERR_ENOUGH) || (type == ERR_NOT_ENOUGH) ) {
-        use = special;
+int64_t *error64_location( void ) {
+    return err_location();
+}
+
+void error64_set_location_hook( error64_location_fn fn ) {
+    err_location = fn ? fn : err_thread_location;
+}
+#endif
+
+// Attribute tables, indexed by ERROR64_GET_A(). Unused slots are zero-filled (empty strings).
+#define ERR_NAME(n, id, str) str,
+#define ERR_LEN(n, id, str) sizeof(str) - 1,
+static const char err_attr_names[256][16] = { "", ERR_ATTRIBUTES(ERR_NAME) };
+static const uint8_t err_attr_lens[256] = { 0, ERR_ATTRIBUTES(ERR_LEN) };
+
+// Noun tables (see error64_glossary_register()). One bounds check plus one load per lookup
+#if defined(_MSC_VER)
+#   define ERR_ALIGN(n) __declspec(align(n))
+#   define ERR_NOINLINE __declspec(noinline)
+#else
+#   define ERR_ALIGN(n) __attribute__((aligned(n)))
+#   define ERR_NOINLINE __attribute__((noinline))
+#endif
+
+// Relaxed atomics, for counters shared across threads. Acquire/release pointer swaps, for catalogs
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#   define ERR_ATOMIC_ADD64(p, v)       _InterlockedExchangeAdd64( (volatile long long *)(p), (long long)(v) )
+#   define ERR_ATOMIC_LOAD32(p)         ( *(volatile uint32_t *)(p) )
+#   define ERR_ATOMIC_ADD32(p, v)       ( (uint32_t)_InterlockedExchangeAdd( (volatile long *)(p), (long)(v) ) )
+#   define ERR_ATOMIC_ACQUIRE32(p)      ( *(volatile uint32_t *)(p) )
+#   define ERR_ATOMIC_RELEASE32(p, v)   ( *(volatile uint32_t *)(p) = (v) )
+#   define ERR_ATOMIC_STORE32(p, v)     ( *(volatile uint32_t *)(p) = (v) )
+#   define ERR_ATOMIC_LOAD64(p)         ( *(volatile uint64_t *)(p) )
+#   define ERR_ATOMIC_CAS32(p, cmp, v)  ( _InterlockedCompareExchange( (volatile long *)(p), (long)(v), (long)(cmp) ) == (long)(cmp) )
+#   define ERR_ATOMIC_CAS64(p, cmp, v)  ( _InterlockedCompareExchange64( (volatile long long *)(p), (long long)(v), (long long)(cmp) ) == (long long)(cmp) )
+#   define ERR_ATOMIC_XCHG64(p, v)      ( (uint64_t)_InterlockedExchange64( (volatile long long *)(p), (long long)(v) ) )
+#   define ERR_ATOMIC_STORE64(p, v)     ( *(volatile int64_t *)(p) = (v) )
+#   define ERR_ATOMIC_ACQUIRE64(p)      ( *(volatile uint64_t *)(p) )
+#   define ERR_ATOMIC_RELEASE64(p, v)   ( *(volatile uint64_t *)(p) = (v) )
+#   define ERR_ATOMIC_FENCE()           MemoryBarrier()
+#   define ERR_ATOMIC_LOADPTR(p)        ( *(void *volatile *)(p) )
+#   define ERR_ATOMIC_XCHGPTR(p, v)     _InterlockedExchangePointer( (void *volatile *)(p), (v) )
+#   define ERR_ATOMIC_CASPTR(p, cmp, v) ( _InterlockedCompareExchangePointer( (void *volatile *)(p), (v), (cmp) ) == (void *)(cmp) )
+#else
+#   define ERR_ATOMIC_ADD64(p, v)       __atomic_fetch_add( (p), (v), __ATOMIC_RELAXED )
+#   define ERR_ATOMIC_LOAD32(p)         __atomic_load_n( (p), __ATOMIC_RELAXED )
+#   define ERR_ATOMIC_ADD32(p, v)       __atomic_fetch_add( (p), (v), __ATOMIC_ACQ_REL )
+#   define ERR_ATOMIC_ACQUIRE32(p)      __atomic_load_n( (p), __ATOMIC_ACQUIRE )
+#   define ERR_ATOMIC_RELEASE32(p, v)   __atomic_store_n( (p), (v), __ATOMIC_RELEASE )
+#   define ERR_ATOMIC_STORE32(p, v)     __atomic_store_n( (p), (v), __ATOMIC_RELAXED )
+#   define ERR_ATOMIC_LOAD64(p)         __atomic_load_n( (p), __ATOMIC_RELAXED )
+#   define ERR_ATOMIC_CAS32(p, cmp, v)  __extension__ ({ uint32_t err_cmp_ = (cmp); __atomic_compare_exchange_n( (p), &err_cmp_, (v), 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED ); })
+#   define ERR_ATOMIC_CAS64(p, cmp, v)  __extension__ ({ uint64_t err_cmp_ = (cmp); __atomic_compare_exchange_n( (p), &err_cmp_, (v), 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED ); })
+#   define ERR_ATOMIC_XCHG64(p, v)      __atomic_exchange_n( (p), (v), __ATOMIC_RELAXED )
+#   define ERR_ATOMIC_STORE64(p, v)     __atomic_store_n( (p), (v), __ATOMIC_RELAXED )
+#   define ERR_ATOMIC_ACQUIRE64(p)      __atomic_load_n( (p), __ATOMIC_ACQUIRE )
+#   define ERR_ATOMIC_RELEASE64(p, v)   __atomic_store_n( (p), (v), __ATOMIC_RELEASE )
+#   define ERR_ATOMIC_FENCE()           __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#   define ERR_ATOMIC_LOADPTR(p)        __atomic_load_n( (p), __ATOMIC_ACQUIRE )
+#   define ERR_ATOMIC_XCHGPTR(p, v)     __atomic_exchange_n( (p), (v), __ATOMIC_ACQ_REL )
+#   define ERR_ATOMIC_CASPTR(p, cmp, v) __extension__ ({ void *err_cmp_ = (cmp); __atomic_compare_exchange_n( (void **)(p), &err_cmp_, (void *)(v), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ); })
+#endif
+
+#ifndef ERROR64_USER_DEFINED_GLOSSARY
+#define ERR_NOUN_NAME(id, str) str,
+#define ERR_NOUN_LEN(id, str) sizeof(str) - 1,
+ERR_ALIGN(64) static const char *const err_noun_names[] = { "", ERR_NOUNS(ERR_NOUN_NAME) };
+ERR_ALIGN(64) static const uint8_t err_noun_lens[] = { 0, ERR_NOUNS(ERR_NOUN_LEN) };
+#undef ERR_NOUN_LEN
+#undef ERR_NOUN_NAME
+#endif
+// Each glossary is either a table or a callback. Per-api slots left empty fall back to the default glossary
+typedef struct err_glossary { const char *const *names; const uint8_t *lens; int count; const char *(*fn)( int ); } err_glossary;
+#ifndef ERROR64_USER_DEFINED_GLOSSARY
+ERR_ALIGN(64) static err_glossary err_nouns = { err_noun_names, err_noun_lens, (int)(sizeof(err_noun_names) / sizeof(err_noun_names[0])), 0 };
+#else
+ERR_ALIGN(64) static err_glossary err_nouns = { 0, 0, 0, glossary };
+#endif
+ERR_ALIGN(64) static err_glossary err_modules[128];
+
+// Glossary of an api [0..127], the default one for -1, NULL otherwise
+static err_glossary *err_glossary_slot( int api ) {
+    return api == -1 ? &err_nouns : api >= 0 && api < 128 ? &err_modules[api] : 0;
+}
+
+void error64_glossary_register( const char *const *names, const uint8_t *lens, int count ) {
+    error64_glossary_register_api( -1, names, lens, count );
+}
+
+// Bumped (release) after every registration or catalog swap; readers acquire it to invalidate cached messages and indexes
+static uint32_t err_glossary_gen;
+
+int error64_glossary_register_api( int api, const char *const *names, const uint8_t *lens, int count ) {
+    err_glossary *g = err_glossary_slot( api );
+    if( !g ) return -1;
+    g->names = names;
+    g->lens = names ? lens : 0;
+    g->count = names ? count : 0;
+    g->fn = names || api >= 0 ? 0 : glossary;
+    ERR_ATOMIC_ADD32( &err_glossary_gen, 1 );
+    return 0;
+}
+
+int error64_glossary_register_fn( int api, const char *(*fn)( int ) ) {
+    err_glossary *g = err_glossary_slot( api );
+    if( !g ) return -1;
+    g->names = 0, g->lens = 0, g->count = 0;
+    g->fn = fn || api >= 0 ? fn : glossary;
+    ERR_ATOMIC_ADD32( &err_glossary_gen, 1 );
+    return 0;
+}
+
+// Precomputed messages (#define ERROR64_PRECOMPUTED_TABLE): every built-in (noun, negate, attribute) triple pre-rendered
+// into one contiguous .rodata pool by error64gen.c ( error64gen > error64_table.h ). Messages are then one lookup plus one memcpy.
+#ifdef ERROR64_PRECOMPUTED_TABLE
+#ifdef ERROR64_USER_DEFINED_GLOSSARY
+#error ERROR64_PRECOMPUTED_TABLE requires the built-in glossary
+#endif
+#include "error64_table.h"
+#endif
+// Shape of the built-in glossary: entry counts plus a position-weighted sum of name sizes, all compile-time constants.
+// error64gen.c stamps them into error64_table.h, so a table generated from an older error64.h fails to build.
+#define ERR_SHAPE_COUNT_ATTR(n, id, str) + 1
+#define ERR_SHAPE_COUNT_NOUN(id, str) + 1
+#define ERR_SHAPE_SUM_ATTR(n, id, str) + (n) * (long)sizeof(str)
+#define ERR_SHAPE_SUM_NOUN(id, str) + (long)NN_##id * (long)sizeof(str)
+#define ERR_SHAPE_ATTRS ( 1 ERR_ATTRIBUTES(ERR_SHAPE_COUNT_ATTR) )
+#define ERR_SHAPE_NOUNS ( 1 ERR_NOUNS(ERR_SHAPE_COUNT_NOUN) )
+#define ERR_SHAPE_CHECKSUM ( 0L ERR_ATTRIBUTES(ERR_SHAPE_SUM_ATTR) ERR_NOUNS(ERR_SHAPE_SUM_NOUN) )
+
+#ifdef ERROR64_CATALOG
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+struct error64_catalog {
+    const void *base; size_t size;
+    const uint32_t *noun_offsets, *attr_offsets;
+    const char *pool;
+    uint32_t nouns, attrs;
+};
+static error64_catalog *err_catalog; // current catalog, swapped atomically
+
+// Entry i of an offsets table (validated at load time)
+static const char *err_catalog_entry( const error64_catalog *c, const uint32_t *offsets, uint32_t i, size_t *len ) {
+    *len = offsets[i + 1] - offsets[i] - 1;
+    return c->pool + offsets[i];
+}
+
+// Offsets must be ascending, in the pool, and each entry '\0'-terminated and shorter than 256 bytes
+static int err_catalog_check( const uint32_t *offsets, uint32_t n, const char *pool, uint32_t pool_size ) {
+    uint32_t i;
+    for( i = 0; i < n; ++i ) {
+        if( offsets[i] >= offsets[i + 1] || offsets[i + 1] > pool_size || offsets[i + 1] - offsets[i] > 256 ) return 0;
+        if( pool[offsets[i + 1] - 1] != '\0' ) return 0;
     }
-    strcpy( buf256, (use)[0] );
-    strcat( buf256, (use)[0][0] ? " " : "" );
-    strcat( buf256, (use)[1] );
-    strcat( buf256, (use)[1][0] ? " " : "" );
-    strcat( buf256, (use)[2] );
-    return (buf256[255] = '\0', buf256);
+    return 1;
 }
 
-// Print error to a [256] char buffer (extended info)
-const char *strerror64ex( char buf256[256], int64_t error64 ) {
-    if( error64 >= 0 ) {
-        sprintf( buf256, "No error ; ERR_%p", (void *)error64 );
+// Append names[n] to the pool, filling offsets[n+1]. Returns the next offsets table
+static uint32_t *err_catalog_put( uint32_t *offsets, const char *const *names, uint32_t n, char *pool, size_t *at ) {
+    uint32_t i;
+    for( i = 0; i < n; ++i ) {
+        size_t len = names[i] ? strlen( names[i] ) : 0;
+        offsets[i] = (uint32_t)*at;
+        memcpy( pool + *at, names[i] ? names[i] : "", len + 1 );
+        *at += len + 1;
+    }
+    offsets[n] = (uint32_t)*at;
+    return offsets + n + 1;
+}
+
+size_t error64_catalog_build( const char *const *nouns, uint32_t num_nouns, const char *const *attrs, uint32_t num_attrs, void *out, size_t cap ) {
+    error64_catalog_header h;
+    size_t pool = 0, need, i;
+    uint32_t *offsets = (uint32_t *)((char *)out + sizeof(h));
+    if( !attrs ) num_attrs = 0;
+    for( i = 0; i < num_nouns; ++i ) pool += (nouns[i] ? strlen( nouns[i] ) : 0) + 1;
+    for( i = 0; i < num_attrs; ++i ) pool += (attrs[i] ? strlen( attrs[i] ) : 0) + 1;
+    need = sizeof(h) + ((size_t)num_nouns + 1 + num_attrs + 1) * sizeof(uint32_t) + pool;
+    if( cap < need ) return need;
+    memcpy( h.magic, ERROR64_CATALOG_MAGIC, 8 );
+    h.version = ERROR64_CATALOG_VERSION, h.nouns = num_nouns, h.attrs = num_attrs, h.pool_size = (uint32_t)pool;
+    memcpy( out, &h, sizeof(h) );
+    pool = 0;
+    offsets = err_catalog_put( offsets, nouns, num_nouns, (char *)(offsets + num_nouns + 1 + num_attrs + 1), &pool );
+    err_catalog_put( offsets, attrs, num_attrs, (char *)(offsets + num_attrs + 1), &pool );
+    return need;
+}
+
+error64_catalog *error64_catalog_open( const char *path ) {
+    error64_catalog *c;
+    const error64_catalog_header *h;
+    const void *base = 0;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE f = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, 0, 0 ), m;
+    LARGE_INTEGER sz;
+    if( f == INVALID_HANDLE_VALUE ) return 0;
+    if( GetFileSizeEx( f, &sz ) && sz.QuadPart > 0 && (m = CreateFileMappingA( f, 0, PAGE_READONLY, 0, 0, 0 )) != 0 ) {
+        base = MapViewOfFile( m, FILE_MAP_READ, 0, 0, 0 );
+        size = (size_t)sz.QuadPart;
+        CloseHandle( m );
+    }
+    CloseHandle( f );
+#else
+    struct stat st;
+    int fd = open( path, O_RDONLY );
+    if( fd < 0 ) return 0;
+    if( !fstat( fd, &st ) && st.st_size > 0 ) {
+        base = mmap( 0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+        size = (size_t)st.st_size;
+        if( base == MAP_FAILED ) base = 0;
+    }
+    close( fd );
+#endif
+    if( !base ) return 0;
+    c = (error64_catalog *)calloc( 1, sizeof(error64_catalog) );
+    h = (const error64_catalog_header *)base;
+    if( c ) {
+        c->base = base, c->size = size;
+        if( size >= sizeof(*h) && !memcmp( h->magic, ERROR64_CATALOG_MAGIC, 8 ) && h->version == ERROR64_CATALOG_VERSION &&
+            h->nouns <= 0x8000 && h->attrs <= 256 &&
+            size == sizeof(*h) + ((size_t)h->nouns + 1 + h->attrs + 1) * sizeof(uint32_t) + h->pool_size ) {
+            c->nouns = h->nouns, c->attrs = h->attrs;
+            c->noun_offsets = (const uint32_t *)(h + 1);
+            c->attr_offsets = c->noun_offsets + c->nouns + 1;
+            c->pool = (const char *)(c->attr_offsets + c->attrs + 1);
+            if( err_catalog_check( c->noun_offsets, c->nouns, c->pool, h->pool_size ) &&
+                err_catalog_check( c->attr_offsets, c->attrs, c->pool, h->pool_size ) ) {
+                return c;
+            }
+        }
+        error64_catalog_close( c );
+        return 0;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile( base );
+#else
+    munmap( (void *)base, size );
+#endif
+    return 0;
+}
+
+error64_catalog *error64_catalog_swap( error64_catalog *c ) {
+    c = (error64_catalog *)ERR_ATOMIC_XCHGPTR( &err_catalog, c );
+    ERR_ATOMIC_ADD32( &err_glossary_gen, 1 );
+    return c;
+}
+
+void error64_catalog_close( error64_catalog *c ) {
+    if( !c ) return;
+#ifdef _WIN32
+    UnmapViewOfFile( c->base );
+#else
+    munmap( (void *)c->base, c->size );
+#endif
+    free( c );
+}
+#endif
+
+static const char *err_noun( int api, int u, size_t *len ) {
+    const err_glossary *g = &err_modules[api];
+    const char *noun;
+    if( !g->names && !g->fn ) {
+#ifdef ERROR64_CATALOG
+        const error64_catalog *c = (const error64_catalog *)ERR_ATOMIC_LOADPTR( &err_catalog );
+        if( c ) {
+            return (uint32_t)u < c->nouns ? err_catalog_entry( c, c->noun_offsets, (uint32_t)u, len ) : (*len = 2, "??");
+        }
+#endif
+        g = &err_nouns;
+    }
+    if( g->fn ) {
+        noun = g->fn( u );
+        return (*len = strlen(noun), noun);
+    }
+    if( u >= g->count ) {
+        return (*len = 2, "??");
+    }
+    noun = g->names[u];
+    return (*len = g->lens ? g->lens[u] : strlen(noun), noun);
+}
+
+// English word order exceptions: "A", "NO", "NO SUCH" and "ENOUGH" go before the noun
+static int err_special( int64_t ec ) {
+    int64_t type = ec & (0x1ffLL << ERR_BIT_A);
+    return (type == ERR_A)  || (type == ERR_NOT_A) ||
+           (type == ERR_NO) || (type == ERR_NO_SUCH) ||
+           (type == ERR_ENOUGH) || (type == ERR_NOT_ENOUGH);
+}
+
+// Split error into its ordered, non-empty fragments, following loc's tables and word order (NULL: English)
+static int err_parts( int64_t ec, const error64_locale *loc, struct error64_parts *out ) {
+    int neg = ERROR64_GET_N(ec), attr = ERROR64_GET_A(ec), u = ERROR64_GET_U(ec), i, n = 0;
+    size_t nlen;
+    const char *noun;
+    error64_fragment frag[3];
+    static const uint8_t common[] = { 0, 1, 2 }, special[] = { 1, 2, 0 };
+    const uint8_t *use = common;
+    if( ec >= 0 ) return out->count = 0;
+    if( loc && loc->nouns && u >= loc->num_nouns ) {
+        frag[0].ptr = "??", frag[0].len = 2;
+    } else if( loc && loc->nouns && loc->nouns[u].ptr ) {
+        frag[0] = loc->nouns[u];
     } else {
-        sprintf( buf256, "%s ; ERR_%p error=%d,api=%d,rev=%d,line=%d,neg=%d,attr=%d,noun=%d",
-            strerror64(buf256, error64),
-            (void *)error64,
-            ERROR64_GET_E(error64),
-            ERROR64_GET_V(error64),
-            ERROR64_GET_R(error64),
-            ERROR64_GET_L(error64),
-            ERROR64_GET_N(error64),
-            ERROR64_GET_A(error64),
-            ERROR64_GET_U(error64)
-        );
+        noun = err_noun( ERROR64_GET_V(ec), u, &nlen );
+        frag[0].ptr = noun, frag[0].len = (uint8_t)(nlen < 255 ? nlen : 255);
     }
-    return buf256;
+    frag[1].ptr = "NOT", frag[1].len = (uint8_t)(neg ? 3 : 0);
+    frag[2].ptr = err_attr_names[attr], frag[2].len = err_attr_lens[attr];
+#ifdef ERROR64_CATALOG
+    {
+        const error64_catalog *c = (const error64_catalog *)ERR_ATOMIC_LOADPTR( &err_catalog );
+        if( c && (uint32_t)attr < c->attrs ) {
+            frag[2].ptr = err_catalog_entry( c, c->attr_offsets, (uint32_t)attr, &nlen ), frag[2].len = (uint8_t)nlen;
+        }
+    }
+#endif
+    if( loc ) {
+        if( loc->attrs && loc->attrs[attr].ptr ) frag[2] = loc->attrs[attr];
+        if( neg && loc->negation.ptr ) frag[1] = loc->negation;
+        if( neg && loc->negated && loc->negated[attr].len ) frag[1].len = 0, frag[2] = loc->negated[attr];
+        use = ( loc->special ? loc->special[neg << 8 | attr] : err_special( ec ) ) ? loc->special_order : loc->order;
+    } else if( err_special( ec ) ) {
+        use = special;
+    }
+    for( i = 0; i < 3; ++i ) {
+        if( frag[use[i] % 3].len ) out->frag[n++] = frag[use[i] % 3];
+    }
+    return out->count = n;
 }
 
-// Function that resolve the glossary enums (nouns) above
-#ifndef ERROR64_USER_DEFINED_GLOSSARY
-const char *glossary( int enumeration ) {
-    switch( enumeration ) {
-        case NN_BLANK: return "";
-        default:  return "??";
-
-        case NN_ACCESS: return "ACCESS";
-        case NN_ACCOUNT: return "ACCOUNT";
-        case NN_ADDRESS: return "ADDRESS";
-        case NN_ADMINISTRATOR: return "ADMINISTRATOR";
-        case NN_API: return "API";
-        case NN_APPLICATION: return "APPLICATION";
-        case NN_ARCHIVE: return "ARCHIVE";
-        case NN_ARGUMENT: return "ARGUMENT";
-        case NN_ASSET: return "ASSET";
-        case NN_AUDIO: return "AUDIO";
-        case NN_AUTHENTICATION: return "AUTHENTICATION";
-        case NN_BINARY: return "BINARY";
-        case NN_BIRTHDATE: return "BIRTHDATE";
-        case NN_BLOB: return "BLOB";
-        case NN_BOX: return "BOX";
-        case NN_BROADCAST: return "BROADCAST";
-        case NN_CAPSULE: return "CAPSULE";
-        case NN_CHECKBOX: return "CHECKBOX";
-        case NN_CINEMATIC: return "CINEMATIC";
-        case NN_CIRCLE: return "CIRCLE";
-        case NN_CLASS: return "CLASS";
-        case NN_CLIENT: return "CLIENT";
-        case NN_CLOUD: return "CLOUD";
-        case NN_CODE: return "CODE";
-        case NN_COMBO: return "COMBO";
-        case NN_COMMIT: return "COMMIT";
-        case NN_COMPILATION: return "COMPILATION";
-        case NN_COMPILER: return "COMPILER";
-        case NN_COMPRESSION: return "COMPRESSION";
-        case NN_CONSOLE: return "CONSOLE";
-        case NN_CONTROLLER: return "CONTROLLER";
-        case NN_COUNTRY: return "COUNTRY";
-        case NN_CVS: return "CVS";
-        case NN_CYPHERING: return "CYPHERING";
-        case NN_DAEMON: return "DAEMON";
-        case NN_DATA: return "DATA";
-        case NN_DEPENDENCY: return "DEPENDENCY";
-        case NN_DESCRIPTOR: return "DESCRIPTOR";
-        case NN_DEVICE: return "DEVICE";
-        case NN_DIAGRAM: return "DIAGRAM";
-        case NN_DIRECTORY: return "DIRECTORY";
-        case NN_DISK: return "DISK";
-        case NN_DLL: return "DLL";
-        case NN_DOMAIN: return "DOMAIN";
-        case NN_DOWNLOAD: return "DOWNLOAD";
-        case NN_DRIVER: return "DRIVER";
-        case NN_EDITOR: return "EDITOR";
-        case NN_ENDPOINT: return "ENDPOINT";
-        case NN_ENGINE: return "ENGINE";
-        case NN_EVALUATION: return "EVALUATION";
-        case NN_EVALUATOR: return "EVALUATOR";
-        case NN_EVENT: return "EVENT";
-        case NN_EXCEPTION: return "EXCEPTION";
-        case NN_EXCHANGE: return "EXCHANGE";
-        case NN_EXPECTATION: return "EXPECTATION";
-        case NN_FETCH: return "FETCH";
-        case NN_FILE: return "FILE";
-        case NN_FLOAT: return "FLOAT";
-        case NN_FLOW: return "FLOW";
-        case NN_FOLDER: return "FOLDER";
-        case NN_FONT: return "FONT";
-        case NN_FORMAT: return "FORMAT";
-        case NN_FUNCTION: return "FUNCTION";
-        case NN_GAME: return "GAME";
-        case NN_GAMEPAD: return "GAMEPAD";
-        case NN_GATEWAY: return "GATEWAY";
-        case NN_GEOMETRY: return "GEOMETRY";
-        case NN_GIZMO: return "GIZMO";
-        case NN_GRAPH: return "GRAPH";
-        case NN_GRAPHICS: return "GRAPHICS";
-        case NN_GROUP: return "GROUP";
-        case NN_HANDLE: return "HANDLE";
-        case NN_HARDWARE: return "HARDWARE";
-        case NN_HEADER: return "HEADER";
-        case NN_HID: return "HID";
-        case NN_HMD: return "HMD";
-        case NN_HOST: return "HOST";
-        case NN_IDENTIFIER: return "IDENTIFIER";
-        case NN_INDEX: return "INDEX";
-        case NN_INPUT: return "INPUT";
-        case NN_INTEGER: return "INTEGER";
-        case NN_INTERFACE: return "INTERFACE";
-        case NN_INTERVAL: return "INTERVAL";
-        case NN_IO: return "IO";
-        case NN_JOYSTICK: return "JOYSTICK";
-        case NN_KEYBOARD: return "KEYBOARD";
-        case NN_LENGTH: return "LENGTH";
-        case NN_LEVEL: return "LEVEL";
-        case NN_LIBRARY: return "LIBRARY";
-        case NN_LIMIT: return "LIMIT";
-        case NN_LINK: return "LINK";
-        case NN_LINKAGE: return "LINKAGE";
-        case NN_LINKER: return "LINKER";
-        case NN_LOCATION: return "LOCATION";
-        case NN_LOGIN: return "LOGIN";
-        case NN_LOOP: return "LOOP";
-        case NN_MACHINE: return "MACHINE";
-        case NN_MEDIA: return "MEDIA";
-        case NN_MEMORY: return "MEMORY";
-        case NN_MESH: return "MESH";
-        case NN_MESSAGE: return "MESSAGE";
-        case NN_METHOD: return "METHOD";
-        case NN_MODEL: return "MODEL";
-        case NN_MODULE: return "MODULE";
-        case NN_MONITOR: return "MONITOR";
-        case NN_MOUSE: return "MOUSE";
-        case NN_NETWORK: return "NETWORK";
-        case NN_NICKNAME: return "NICKNAME";
-        case NN_NODE: return "NODE";
-        case NN_NOTHING: return "NOTHING";
-        case NN_NUMBER: return "NUMBER";
-        case NN_OBJECT: return "OBJECT";
-        case NN_OPERATION: return "OPERATION";
-        case NN_OPERATOR: return "OPERATOR";
-        case NN_ORIENTATION: return "ORIENTATION";
-        case NN_PACKAGE: return "PACKAGE";
-        case NN_PASSWORD: return "PASSWORD";
-        case NN_PATH: return "PATH";
-        case NN_PATHFILE: return "PATHFILE";
-        case NN_PAYMENT: return "PAYMENT";
-        case NN_PAYWALL: return "PAYWALL";
-        case NN_PEER: return "PEER";
-        case NN_PERMISSION: return "PERMISSION";
-        case NN_PHYSICS: return "PHYSICS";
-        case NN_PLATFORM: return "PLATFORM";
-        case NN_PLUGIN: return "PLUGIN";
-        case NN_POSITION: return "POSITION";
-        case NN_POSTCONDITION: return "POSTCONDITION";
-        case NN_PRECONDITION: return "PRECONDITION";
-        case NN_PROFILER: return "PROFILER";
-        case NN_PROTOCOL: return "PROTOCOL";
-        case NN_PROXY: return "PROXY";
-        case NN_QUERY: return "QUERY";
-        case NN_RANGE: return "RANGE";
-        case NN_RATIO: return "RATIO";
-        case NN_RECORD: return "RECORD";
-        case NN_RENDERER: return "RENDERER";
-        case NN_REPOSITORY: return "REPOSITORY";
-        case NN_REQUEST: return "REQUEST";
-        case NN_RESOURCE: return "RESOURCE";
-        case NN_REVISION: return "REVISION";
-        case NN_ROTATION: return "ROTATION";
-        case NN_ROUTE: return "ROUTE";
-        case NN_RUNTIME: return "RUNTIME";
-        case NN_SCALE: return "SCALE";
-        case NN_SCREEN: return "SCREEN";
-        case NN_SCRIPT: return "SCRIPT";
-        case NN_SEARCH: return "SEARCH";
-        case NN_SEQUENCE: return "SEQUENCE";
-        case NN_SERIALIZATION: return "SERIALIZATION";
-        case NN_SERVER: return "SERVER";
-        case NN_SERVICE: return "SERVICE";
-        case NN_SHADER: return "SHADER";
-        case NN_SHAPE: return "SHAPE";
-        case NN_SIZE: return "SIZE";
-        case NN_SLIDER: return "SLIDER";
-        case NN_SOFTWARE: return "SOFTWARE";
-        case NN_SOURCE: return "SOURCE";
-        case NN_SPACE: return "SPACE";
-        case NN_SPHERE: return "SPHERE";
-        case NN_SQUARE: return "SQUARE";
-        case NN_STACK: return "STACK";
-        case NN_STACKTRACE: return "STACKTRACE";
-        case NN_STAGE: return "STAGE";
-        case NN_STARTPOINT: return "STARTPOINT";
-        case NN_STREAM: return "STREAM";
-        case NN_STREAMING: return "STREAMING";
-        case NN_STRING: return "STRING";
-        case NN_STRUCT: return "STRUCT";
-        case NN_SUBSYSTEM: return "SUBSYSTEM";
-        case NN_SYMBOL: return "SYMBOL";
-        case NN_SYSTEM: return "SYSTEM";
-        case NN_TEXT: return "TEXT";
-        case NN_TIME: return "TIME";
-        case NN_TOUCH: return "TOUCH";
-        case NN_TRANSFORM: return "TRANSFORM";
-        case NN_TRANSLATION: return "TRANSLATION";
-        case NN_TRANSPORT: return "TRANSPORT";
-        case NN_TRIGGER: return "TRIGGER";
-        case NN_TRUETYPE: return "TRUETYPE";
-        case NN_TYPE: return "TYPE";
-        case NN_UPGRADE: return "UPGRADE";
-        case NN_UPLOAD: return "UPLOAD";
-        case NN_USER: return "USER";
-        case NN_USERNAME: return "USERNAME";
-        case NN_VALUE: return "VALUE";
-        case NN_VARIANT: return "VARIANT";
-        case NN_VERSION: return "VERSION";
-        case NN_VISUALIZER: return "VISUALIZER";
-        case NN_WEBPAGE: return "WEBPAGE";
-        case NN_WEBSITE: return "WEBSITE";
-        case NN_WEBVIEW: return "WEBVIEW";
-        case NN_WIDGET: return "WIDGET";
-        case NN_WINDOW: return "WINDOW";
-        case NN_ZIPCODE: return "ZIPCODE";
+int error64_parts( int64_t ec, struct error64_parts *out ) {
+    return err_parts( ec, 0, out );
+}
+
+// Join fragments with sep into buf[cap]. Returns written length (truncated to cap-1, '\0' excluded)
+static size_t err_join( char *buf, size_t cap, const struct error64_parts *parts, const char *sep, size_t seplen ) {
+    size_t at = 0, k;
+    int i;
+    for( i = 0; i < parts->count; ++i ) {
+        if( at ) {
+            k = seplen < cap - 1 - at ? seplen : cap - 1 - at;
+            memcpy( buf + at, sep, k );
+            at += k;
+        }
+        k = parts->frag[i].len < cap - 1 - at ? parts->frag[i].len : cap - 1 - at;
+        memcpy( buf + at, parts->frag[i].ptr, k );
+        at += k;
+    }
+    buf[at] = '\0';
+    return at;
+}
+
+#ifdef ERROR64_PRECOMPUTED_TABLE
+// Pre-rendered message of an error, or NULL when glossaries were replaced or the code is out of the table
+static const char *err_table_lookup( int64_t ec, size_t *len ) {
+    int neg = ERROR64_GET_N(ec), attr = ERROR64_GET_A(ec), api = ERROR64_GET_V(ec), u = ERROR64_GET_U(ec);
+    // stale error64_table.h? regenerate it: error64gen > error64_table.h
+    (void)sizeof(char[ ERROR64_TABLE_NOUNS == ERR_SHAPE_NOUNS && ERROR64_TABLE_ATTRS == ERR_SHAPE_ATTRS &&
+                       ERROR64_TABLE_CHECKSUM == ERR_SHAPE_CHECKSUM ? 1 : -1 ]);
+    if( u < ERROR64_TABLE_NOUNS && attr < ERROR64_TABLE_ATTRS && err_nouns.names == err_noun_names &&
+        !err_modules[api].names && !err_modules[api].fn
+#ifdef ERROR64_CATALOG
+        && !ERR_ATOMIC_LOADPTR( &err_catalog )
+#endif
+        ) {
+        uint32_t idx = (uint32_t)( (u * 2 + neg) * ERROR64_TABLE_ATTRS + attr ), at = error64_table_offsets[idx];
+        *len = error64_table_offsets[idx + 1] - at - 1;
+        return error64_table_pool + at;
     }
+    return 0;
 }
 #endif
 
-#endif // ERROR64_DEFINE_IMPLEMENTATION
+// Print error to a [cap] char buffer. Returns written length (truncated to cap-1, '\0' excluded)
+size_t strerror64_n( char *buf, size_t cap, int64_t ec ) {
+    if( !cap ) return 0;
+    if( ec >= 0 ) return (buf[0] = '\0', 0);
+#ifdef ERROR64_PRECOMPUTED_TABLE
+    size_t n;
+    const char *msg = err_table_lookup( ec, &n );
+    if( msg ) {
+        if( n > cap - 1 ) n = cap - 1;
+        memcpy( buf, msg, n );
+        buf[n] = '\0';
+        return n;
+    }
+#endif
+    struct error64_parts parts;
+    err_parts( ec, 0, &parts );
+    return err_join( buf, cap, &parts, " ", 1 );
+}
 
-#ifdef __cplusplus
+size_t strerror64_l_n( char *buf, size_t cap, int64_t ec, const error64_locale *loc ) {
+    struct error64_parts parts;
+    const char *sep = loc && loc->separator ? loc->separator : " ";
+    if( !loc ) return strerror64_n( buf, cap, ec );
+    if( !cap ) return 0;
+    err_parts( ec, loc, &parts );
+    return err_join( buf, cap, &parts, sep, strlen(sep) );
+}
+
+const char *strerror64_l( char buf256[256], int64_t ec, const error64_locale *loc ) {
+    strerror64_l_n( buf256, 256, ec, loc );
+    return buf256;
 }
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__LITTLE_ENDIAN__) || defined(__ARM_NEON) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_neon.h>
+#define ERR_NEON 1
 #endif
 
-#endif // ERROR64_H
+void error64_decode_batch( const int64_t *codes, size_t n, struct error64_fields *soa_out ) {
+    struct error64_fields o = *soa_out;
+    size_t i = 0;
+#if defined(__AVX2__)
+    // split 8 codes into lo/hi 32-bit halves, extract fields on 32-bit lanes, then narrow
+    const __m256i even = _mm256_setr_epi32( 0, 2, 4, 6, 1, 3, 5, 7 );
+    for( ; i + 8 <= n; i += 8 ) {
+        __m256i c0 = _mm256_permutevar8x32_epi32( _mm256_loadu_si256( (const __m256i *)(codes + i) ), even );
+        __m256i c1 = _mm256_permutevar8x32_epi32( _mm256_loadu_si256( (const __m256i *)(codes + i + 4) ), even );
+        __m256i lo = _mm256_permute2x128_si256( c0, c1, 0x20 ), hi = _mm256_permute2x128_si256( c0, c1, 0x31 );
+        __m256i fe = _mm256_srli_epi32( hi, 31 );
+        __m256i fv = _mm256_and_si256( _mm256_srli_epi32( hi, 24 ), _mm256_set1_epi32( 0x7f ) );
+        __m256i fr = _mm256_and_si256( _mm256_srli_epi32( hi, 8 ), _mm256_set1_epi32( 0xffff ) );
+        __m256i fl = _mm256_or_si256( _mm256_srli_epi32( lo, 24 ), _mm256_slli_epi32( _mm256_and_si256( hi, _mm256_set1_epi32( 0xff ) ), 8 ) );
+        __m256i fn = _mm256_and_si256( _mm256_srli_epi32( lo, 23 ), _mm256_set1_epi32( 0x1 ) );
+        __m256i fa = _mm256_and_si256( _mm256_srli_epi32( lo, 15 ), _mm256_set1_epi32( 0xff ) );
+        __m256i fu = _mm256_and_si256( lo, _mm256_set1_epi32( 0x7fff ) );
+#       define ERR_STORE16(dst, v) _mm_storeu_si128( (__m128i *)(dst + i), _mm_packus_epi32( _mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1) ) )
+#       define ERR_STORE8(dst, v) _mm_storel_epi64( (__m128i *)(dst + i), _mm_packus_epi16( _mm_packus_epi32( _mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1) ), _mm_setzero_si128() ) )
+        ERR_STORE8( o.e, fe ); ERR_STORE8( o.v, fv ); ERR_STORE16( o.r, fr ); ERR_STORE16( o.l, fl );
+        ERR_STORE8( o.n, fn ); ERR_STORE8( o.a, fa ); ERR_STORE16( o.u, fu );
+#       undef ERR_STORE8
+#       undef ERR_STORE16
+    }
+#elif defined(ERR_NEON)
+    // vld2q deinterleaves 4 codes into lo/hi 32-bit halves
+    for( ; i + 4 <= n; i += 4 ) {
+        uint32x4x2_t c = vld2q_u32( (const uint32_t *)(codes + i) );
+        uint32x4_t lo = c.val[0], hi = c.val[1];
+        uint32x4_t fe = vshrq_n_u32( hi, 31 );
+        uint32x4_t fv = vandq_u32( vshrq_n_u32( hi, 24 ), vdupq_n_u32( 0x7f ) );
+        uint32x4_t fr = vandq_u32( vshrq_n_u32( hi, 8 ), vdupq_n_u32( 0xffff ) );
+        uint32x4_t fl = vorrq_u32( vshrq_n_u32( lo, 24 ), vshlq_n_u32( vandq_u32( hi, vdupq_n_u32( 0xff ) ), 8 ) );
+        uint32x4_t fn = vandq_u32( vshrq_n_u32( lo, 23 ), vdupq_n_u32( 0x1 ) );
+        uint32x4_t fa = vandq_u32( vshrq_n_u32( lo, 15 ), vdupq_n_u32( 0xff ) );
+        uint32x4_t fu = vandq_u32( lo, vdupq_n_u32( 0x7fff ) );
+#       define ERR_STORE16(dst, v) vst1_u16( dst + i, vmovn_u32(v) )
+        // 4 bytes to an unaligned uint8_t array: memcpy (a single str) instead of a type-punned uint32_t store
+#       define ERR_STORE8(dst, v) do { uint32_t w4_ = vget_lane_u32( vreinterpret_u32_u8( vmovn_u16( vcombine_u16( vmovn_u32(v), vdup_n_u16(0) ) ) ), 0 ); memcpy( dst + i, &w4_, 4 ); } while( 0 )
+        ERR_STORE8( o.e, fe ); ERR_STORE8( o.v, fv ); ERR_STORE16( o.r, fr ); ERR_STORE16( o.l, fl );
+        ERR_STORE8( o.n, fn ); ERR_STORE8( o.a, fa ); ERR_STORE16( o.u, fu );
+#       undef ERR_STORE8
+#       undef ERR_STORE16
+    }
+#endif
+    for( ; i < n; ++i ) {
+        int64_t ec = codes[i];
+        o.e[i] = (uint8_t)ERROR64_GET_E(ec);
+        o.v[i] = (uint8_t)ERROR64_GET_V(ec);
+        o.r[i] = (uint16_t)ERROR64_GET_R(ec);
+        o.l[i] = (uint16_t)ERROR64_GET_L(ec);
+        o.n[i] = (uint8_t)ERROR64_GET_N(ec);
+        o.a[i] = (uint8_t)ERROR64_GET_A(ec);
+        o.u[i] = (uint16_t)ERROR64_GET_U(ec);
+    }
+}
 
-#ifdef ERROR64_BUILD_DEMO
+size_t strerror64_batch( const int64_t *codes, size_t n, char *arena, size_t cap, uint32_t *offsets ) {
+    size_t i, at = 0;
+    for( i = 0; i < n && cap - at >= 256; ++i ) {
+        offsets[i] = (uint32_t)at;
+        at += strerror64_n( arena + at, 256, codes[i] ) + 1;
+    }
+    offsets[i] = (uint32_t)at;
+    return i;
+}
 
-// Our sample
-#include <assert.h>
-#include <string.h>
+static uint8_t *err_put_varint( uint8_t *p, uint32_t v ) {
+    for( ; v >= 0x80; v >>= 7 ) *p++ = (uint8_t)(v | 0x80);
+    *p++ = (uint8_t)v;
+    return p;
+}
 
-int main() {
-    char buf256[256];
+size_t error64_encode( const int64_t *codes, size_t n, uint8_t *out, size_t cap, size_t *len ) {
+    uint8_t *p = out;
+    size_t i;
+    int32_t vr = -1; // api/rev of previous record, none yet
+    for( i = 0; i < n && cap - (size_t)(p - out) >= ERROR64_WIRE_MAX; ++i ) {
+        int64_t ec = codes[i];
+        int32_t v = ERROR64_GET_V(ec), r = ERROR64_GET_R(ec);
+        uint8_t *tag = p++;
+        *tag = (uint8_t)( ERROR64_GET_E(ec) << 7 | ERROR64_GET_N(ec) << 6 );
+        if( (v << 16 | r) != vr ) {
+            *tag |= 0x20;
+            *p++ = (uint8_t)v;
+            p = err_put_varint( p, (uint32_t)r );
+            vr = v << 16 | r;
+        }
+        p = err_put_varint( p, (uint32_t)ERROR64_GET_L(ec) );
+        *p++ = (uint8_t)ERROR64_GET_A(ec);
+        p = err_put_varint( p, (uint32_t)ERROR64_GET_U(ec) );
+    }
+    if( len ) *len = (size_t)(p - out);
+    return i;
+}
 
-    // simplest case: errno64 showcase
-    errno64 = ERROR64(NN_SERVICE | ERR_NOT_AVAILABLE);
-    printf(">> %s\n", strerror64(buf256, errno64) );
-    printf(">> %s\n", strerror64ex(buf256, errno64) );
+// Read a varint of at most 3 bytes (16-bit fields) into *v. Returns the end pointer, or NULL if truncated/too long
+static const uint8_t *err_get_varint( const uint8_t *p, const uint8_t *end, uint32_t *v ) {
+    int shift;
+    for( *v = 0, shift = 0; p < end && shift < 21; shift += 7 ) {
+        *v |= (uint32_t)(*p & 0x7f) << shift;
+        if( !(*p++ & 0x80) ) return *v <= 0xffff ? p : 0;
+    }
+    return 0;
+}
 
-//  test suite {
-#   define TEST(errcode, str) ( strerror64(buf256, errcode), printf("[%s] %s\n", strcmp(str,buf256) ? "FAIL" : " OK ", buf256) )
+size_t error64_decode( const uint8_t *in, size_t len, int64_t *codes, size_t n ) {
+    const uint8_t *p = in, *end = in + len;
+    size_t i;
+    uint64_t vr = 0;
+    int have_vr = 0;
+    for( i = 0; i < n && p < end; ++i ) {
+        uint8_t tag = *p++;
+        uint32_t r, l, u;
+        if( tag & 0x1f ) break;
+        if( tag & 0x20 ) {
+            if( p >= end || *p > 0x7f ) break;
+            vr = (uint64_t)*p++ << ERR_BIT_V;
+            if( !(p = err_get_varint( p, end, &r )) ) break;
+            vr |= (uint64_t)r << ERR_BIT_R;
+            have_vr = 1;
+        }
+        if( !have_vr ) break;
+        if( !(p = err_get_varint( p, end, &l )) || p >= end ) break;
+        codes[i] = (int64_t)( (uint64_t)(tag >> 7) << ERR_BIT_E | vr | (uint64_t)l << ERR_BIT_L |
+            (uint64_t)((tag >> 6) & 1) << ERR_BIT_N | (uint64_t)*p++ << ERR_BIT_A );
+        if( !(p = err_get_varint( p, end, &u )) || u > 0x7fff ) break;
+        codes[i] |= u;
+    }
+    return i;
+}
 
-    // simple attributes
-    TEST( ERROR64(ERR_NOT_ALLOWED), "NOT ALLOWED");
-    TEST( ERROR64(ERR_NOT_FOUND), "NOT FOUND" );
-    TEST( ERROR64(ERR_INVALID), "NOT VALID" );
+// Print error to a [256] char buffer
+const char *strerror64( char buf256[256], int64_t ec ) {
+    strerror64_n( buf256, 256, ec );
+    return buf256;
+}
 
-    // composited attributes
-    TEST( ERROR64(ERR_NOT | ERR_NEEDED), "NOT NEEDED");
-    TEST( ERROR64(ERR_NOT | ERR_AVAILABLE), "NOT AVAILABLE");
+// Integer writers for strerror64ex(): no locale, no varargs. All return the end pointer.
+static const char err_digits2[201] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+static char *err_put_u32( char *p, uint32_t v ) {
+    char tmp[10], *t = tmp + 10;
+    while( v >= 100 ) { t -= 2; memcpy( t, err_digits2 + (v % 100) * 2, 2 ); v /= 100; }
+    if( v >= 10 ) { t -= 2; memcpy( t, err_digits2 + v * 2, 2 ); } else *--t = (char)('0' + v);
+    memcpy( p, t, (size_t)(tmp + 10 - t) );
+    return p + (tmp + 10 - t);
+}
+static char *err_put_x64( char *p, uint64_t v ) {
+    int i;
+    for( i = 15; i >= 0; --i, v >>= 4 ) p[i] = "0123456789ABCDEF"[v & 0xf];
+    return p + 16;
+}
+static char *err_put_x32( char *p, uint32_t v ) {
+    int i;
+    for( i = 7; i >= 0; --i, v >>= 4 ) p[i] = "0123456789ABCDEF"[v & 0xf];
+    return p + 8;
+}
+#define ERR_PUT(p, lit) ( memcpy( p, lit, sizeof(lit) - 1 ), (p) += sizeof(lit) - 1 )
 
-    // app-defined nouns + attributes
-    TEST( ERROR64(NN_MEMORY | ERR_OUT_OF_RANGE), "MEMORY OUT OF RANGE");
-    TEST( ERROR64(NN_STACK | ERR_OVERFLOW), "STACK OVERFLOW");
-    TEST( ERROR64(NN_EXCEPTION | ERR_THROWN), "EXCEPTION THROWN");
-    TEST( ERROR64(NN_DISK | ERR_FULL), "DISK FULL");
-    TEST( ERROR64(NN_FILE | ERR_NOT_FOUND), "FILE NOT FOUND" );
-    TEST( ERROR64(NN_PROTOCOL | ERR_NOT_AVAILABLE), "PROTOCOL NOT AVAILABLE");
-    TEST( ERROR64(NN_CLIENT | ERR_NOT_AUTHORIZED), "CLIENT NOT AUTHORIZED");
-    TEST( ERROR64(NN_USER | ERR_NOT_REGISTERED), "USER NOT REGISTERED");
-    TEST( ERROR64(NN_REPOSITORY | ERR_NOT_CREATED), "REPOSITORY NOT CREATED");
-    TEST( ERROR64(NN_WEBSITE | ERR_NOT_RESPONDING), "WEBSITE NOT RESPONDING");
-    TEST( ERROR64(NN_WIDGET | ERR_TOO_COMPLEX), "WIDGET TOO COMPLEX");
+// Print error to a [cap] char buffer (extended info). Returns written length (truncated to cap-1, '\0' excluded)
+size_t strerror64ex_n( char *buf, size_t cap, int64_t error64 ) {
+    char ext[128], *p = ext;
+    size_t at = 0, k;
+    if( !cap ) return 0;
+    if( error64 >= 0 ) {
+        ERR_PUT( p, "No error" );
+    } else {
+        at = strerror64_n( buf, cap, error64 );
+    }
+    ERR_PUT( p, " ; ERR_" ); p = err_put_x64( p, (uint64_t)error64 );
+    if( error64 < 0 ) {
+        ERR_PUT( p, " error=" ); p = err_put_u32( p, ERROR64_GET_E(error64) );
+        ERR_PUT( p, ",api=" );   p = err_put_u32( p, ERROR64_GET_V(error64) );
+        ERR_PUT( p, ",rev=" );   p = err_put_u32( p, ERROR64_GET_R(error64) );
+        ERR_PUT( p, ",line=" );  p = err_put_u32( p, ERROR64_GET_L(error64) );
+        ERR_PUT( p, ",neg=" );   p = err_put_u32( p, ERROR64_GET_N(error64) );
+        ERR_PUT( p, ",attr=" );  p = err_put_u32( p, ERROR64_GET_A(error64) );
+        ERR_PUT( p, ",noun=" );  p = err_put_u32( p, ERROR64_GET_U(error64) );
+    }
+    k = (size_t)(p - ext) < cap - 1 - at ? (size_t)(p - ext) : cap - 1 - at;
+    memcpy( buf + at, ext, k );
+    at += k;
+    buf[at] = '\0';
+    return at;
+}
 
-    // app-defined nouns + composed attributes
-    TEST( ERROR64(ERR_NOT | ERR_A | NN_DIRECTORY), "NOT A DIRECTORY" );
-    TEST( ERROR64(ERR_NOT | ERR_ENOUGH | NN_SPACE), "NOT ENOUGH SPACE" );
+// Print error to a [256] char buffer (extended info)
+const char *strerror64ex( char buf256[256], int64_t error64 ) {
+    strerror64ex_n( buf256, 256, error64 );
+    return buf256;
+}
+
+// Text parser: hashed (FNV-1a, linear probing) indexes over attribute and noun names
+#ifndef ERROR64_PARSE_SLOTS
+#define ERROR64_PARSE_SLOTS 4096        // noun index size (power of two); more nouns fall back to a linear scan
+#endif
+static uint8_t err_parse_attrs[512];                        // attribute + 1, 0 marks empty slots
+static size_t err_parse_words;                              // longest attribute, in words
+static uint32_t err_parse_attrs_state;                      // 0: not built, 1: building, 2: ready (release)
+
+// Noun index over the nouns short messages print with (err_noun() of api 0: its glossary, a loaded catalog, or the default
+// glossary, table or callback). Slots hold noun codes only, so names are always read from the glossary in use.
+// A registration makes the next parser build a fresh index and swap it in; replaced indexes stay allocated (linked from
+// the current one), since other threads may still be reading them
+typedef struct err_parse_index {
+    uint32_t gen;                                           // err_glossary_gen the index was built at
+    int scan;                                               // highest named noun + 1; 0 unless nouns overflowed the slots
+    struct err_parse_index *retired;
+    uint16_t slots[ERROR64_PARSE_SLOTS];                    // noun, 0 marks empty slots
+} err_parse_index;
+static err_parse_index *err_parse_current;
+
+static uint32_t err_parse_hash( const char *s, size_t len ) {
+    uint32_t h = 2166136261u;
+    while( len-- ) h = (h ^ (uint8_t)*s++) * 16777619u;
+    return h;
+}
+
+// Attribute names never change: one thread builds their index, the others wait for it
+static void err_parse_init_attrs( void ) {
+    int i;
+    uint32_t h;
+    if( ERR_ATOMIC_ACQUIRE32( &err_parse_attrs_state ) == 2 ) return;
+    if( !ERR_ATOMIC_CAS32( &err_parse_attrs_state, 0, 1 ) ) {
+        while( ERR_ATOMIC_ACQUIRE32( &err_parse_attrs_state ) != 2 ) {}
+        return;
+    }
+    for( i = 1; i < 256; ++i ) {
+        size_t w = 1, k;
+        if( !err_attr_lens[i] ) continue;
+        for( k = 0; k < err_attr_lens[i]; ++k ) w += err_attr_names[i][k] == ' ';
+        if( err_parse_words < w ) err_parse_words = w;
+        for( h = err_parse_hash( err_attr_names[i], err_attr_lens[i] ); err_parse_attrs[h & 511]; ++h ) {}
+        err_parse_attrs[h & 511] = (uint8_t)i;
+    }
+    ERR_ATOMIC_RELEASE32( &err_parse_attrs_state, 2 );
+}
+
+// Current noun index, rebuilt after registrations. NULL if it cannot be allocated (lookups scan the glossary instead)
+static const err_parse_index *err_parse_init( void ) {
+    err_parse_index *cur = (err_parse_index *)ERR_ATOMIC_LOADPTR( &err_parse_current ), *x;
+    uint32_t gen = ERR_ATOMIC_ACQUIRE32( &err_glossary_gen ), h;
+    int i, used, last;
+    size_t len;
+    err_parse_init_attrs();
+    if( cur && cur->gen == gen ) return cur;
+    if( (x = (err_parse_index *)calloc( 1, sizeof(err_parse_index) )) == 0 ) return 0;
+    x->gen = gen, x->retired = cur;
+    // every U field value is asked for, so callbacks are indexed too ("??" and "" are not names)
+    for( i = 1, used = 0, last = 0; i <= 0x7fff; ++i ) {
+        const char *name = err_noun( 0, i, &len );
+        if( !len || (len == 2 && !memcmp( name, "??", 2 )) ) continue;
+        last = i;
+        if( ++used > ERROR64_PARSE_SLOTS / 2 ) continue;
+        for( h = err_parse_hash( name, len ); x->slots[h & (ERROR64_PARSE_SLOTS - 1)]; ++h ) {}
+        x->slots[h & (ERROR64_PARSE_SLOTS - 1)] = (uint16_t)i;
+    }
+    if( used > ERROR64_PARSE_SLOTS / 2 ) x->scan = last + 1;
+    if( ERR_ATOMIC_CASPTR( &err_parse_current, cur, x ) ) return x;
+    // another thread swapped first: use its index
+    free( x );
+    return (const err_parse_index *)ERR_ATOMIC_LOADPTR( &err_parse_current );
+}
+
+// Attribute code of s[len], or 0
+static int err_parse_attr( const char *s, size_t len ) {
+    uint32_t h;
+    int a;
+    if( len > 15 ) return 0;
+    for( h = err_parse_hash( s, len ); (a = err_parse_attrs[h & 511]) != 0; ++h ) {
+        if( err_attr_lens[a] == len && !memcmp( err_attr_names[a], s, len ) ) return a;
+    }
+    return 0;
+}
+
+// Noun code of s[len] (as printed by api 0), or -1
+static int err_parse_noun( const err_parse_index *x, const char *s, size_t len ) {
+    const char *name;
+    size_t n;
+    uint32_t h;
+    int u, scan = x ? x->scan : 0x8000;
+    if( !len ) return 0;
+    if( len == 2 && !memcmp( s, "??", 2 ) ) return -1; // unlisted nouns
+    if( scan ) {
+        for( u = 1; u < scan; ++u ) {
+            if( (name = err_noun( 0, u, &n )) != 0 && n == len && !memcmp( name, s, len ) ) return u;
+        }
+        return -1;
+    }
+    for( h = err_parse_hash( s, len ); (u = x->slots[h & (ERROR64_PARSE_SLOTS - 1)]) != 0; ++h ) {
+        if( (name = err_noun( 0, u, &n )) != 0 && n == len && !memcmp( name, s, len ) ) return u;
+    }
+    return -1;
+}
+
+// Special-order messages, as in error64_parts(): "[NOT] ADJ [NOUN]"
+static int64_t err_parse_special( const err_parse_index *x, const char *s, size_t len ) {
+    int neg = len >= 4 && !memcmp( s, "NOT ", 4 ), attr, u;
+    size_t at = neg * 4, i;
+    for( i = at; i <= len; ++i ) {
+        if( i == len || s[i] == ' ' ) {
+            int64_t type = ( (int64_t)neg << ERR_BIT_N ) | ( (int64_t)(attr = err_parse_attr( s + at, i - at )) << ERR_BIT_A );
+            if( (type == ERR_A) || (type == ERR_NOT_A) || (type == ERR_NO) || (type == ERR_NO_SUCH) ||
+                (type == ERR_ENOUGH) || (type == ERR_NOT_ENOUGH) ) {
+                size_t n = i + (i < len);
+                if( (u = err_parse_noun( x, s + n, len - n )) >= 0 ) return ERR_ERROR | type | u;
+            }
+        }
+    }
+    return 0;
+}
+
+// Common-order messages: "[NOUN] [NOT] [ADJ]", with the attribute at s[at..len) (empty if at == len)
+static int64_t err_parse_common( const err_parse_index *x, const char *s, size_t len, size_t at ) {
+    size_t pre = at == len ? len : at ? at - 1 : 0;
+    int attr = at == len ? 0 : err_parse_attr( s + at, len - at ), neg, u;
+    if( at != len && !attr ) return 0;
+    neg = pre >= 3 && !memcmp( s + pre - 3, "NOT", 3 ) && (pre == 3 || s[pre - 4] == ' ');
+    if( neg ) pre = pre > 3 ? pre - 4 : 0;
+    if( (u = err_parse_noun( x, s, pre )) < 0 || !(attr || neg || u) ) return 0;
+    return ERR_ERROR | ((int64_t)neg << ERR_BIT_N) | ((int64_t)attr << ERR_BIT_A) | u;
+}
+
+int64_t strtoerror64( const char *s, size_t len ) {
+    const char *end, *p;
+    size_t i, words;
+    int64_t ec;
+    const err_parse_index *x = err_parse_init();
+    while( len && (uint8_t)s[len - 1] <= ' ' ) --len;
+    end = s + len;
+
+    // extended form: "message ; ERR_<hex> ..." ("0x" prefix accepted for older %p output)
+    for( p = s; p + 7 <= end; ++p ) {
+        if( p[0] == ' ' && p[1] == ';' && p[2] == ' ' && !memcmp( p + 3, "ERR_", 4 ) ) {
+            uint64_t v = 0;
+            int digits = 0;
+            p += 7;
+            if( p + 2 <= end && p[0] == '0' && (p[1] == 'x' || p[1] == 'X') ) p += 2;
+            for( ; p < end && digits < 16; ++p, ++digits ) {
+                int c = *p, d = c >= '0' && c <= '9' ? c - '0' : c >= 'A' && c <= 'F' ? c - 'A' + 10 : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+                if( d < 0 ) break;
+                v = v << 4 | (uint64_t)d;
+            }
+            return digits ? (int64_t)v : 0;
+        }
+    }
+    if( !len ) return 0;
+
+    if( (ec = err_parse_special( x, s, len )) != 0 ) return ec;
+    // attributes span a few words; messages without attribute go last
+    for( i = len, words = 0; i-- > 0 && words < err_parse_words; ) {
+        if( (i == 0 || s[i - 1] == ' ') && (++words, ec = err_parse_common( x, s, len, i )) != 0 ) return ec;
+    }
+    return err_parse_common( x, s, len, len );
+}
+
+// Bounded output for structured emitters: everything or nothing
+typedef struct err_sink { char *p, *end; int full; } err_sink;
+static void err_sink_put( err_sink *s, const char *src, size_t n ) {
+    if( s->full || (size_t)(s->end - s->p) < n ) { s->full = 1; return; }
+    memcpy( s->p, src, n );
+    s->p += n;
+}
+static void err_sink_u32( err_sink *s, uint32_t v ) {
+    char tmp[10];
+    err_sink_put( s, tmp, (size_t)(err_put_u32( tmp, v ) - tmp) );
+}
+// Quoted-string body: '"', '\\' and control characters are escaped (JSON rules, also valid logfmt)
+static void err_sink_text( err_sink *s, const char *src, size_t n ) {
+    size_t i, run = 0;
+    for( i = 0; i < n; ++i ) {
+        uint8_t c = (uint8_t)src[i];
+        if( c >= 0x20 && c != '"' && c != '\\' ) continue;
+        err_sink_put( s, src + run, i - run ), run = i + 1;
+        if( c == '"' || c == '\\' ) {
+            char esc[2] = { '\\', (char)c };
+            err_sink_put( s, esc, 2 );
+        } else {
+            char esc[6] = { '\\', 'u', '0', '0', "0123456789abcdef"[c >> 4], "0123456789abcdef"[c & 15] };
+            err_sink_put( s, esc, 6 );
+        }
+    }
+    err_sink_put( s, src + run, n - run );
+}
+
+static size_t err_emit( char *buf, size_t cap, int64_t ec, int format ) {
+    static const char *const keys[2][10] = {
+        { "{\"code\":\"", "\",\"error\":", ",\"api\":", ",\"rev\":", ",\"line\":", ",\"neg\":", ",\"attr\":", ",\"noun\":", ",\"message\":\"", "\"}" },
+        { "code=", " error=", " api=", " rev=", " line=", " neg=", " attr=", " noun=", " msg=\"", "\"" },
+    };
+    const char *const *k = keys[format & 1];
+    int32_t fields[7];
+    struct error64_parts parts;
+    char hex[16];
+    err_sink s;
+    int i;
+    if( !cap ) return 0;
+    s.p = buf, s.end = buf + cap - 1, s.full = 0;
+    fields[0] = ERROR64_GET_E(ec), fields[1] = ERROR64_GET_V(ec), fields[2] = ERROR64_GET_R(ec), fields[3] = ERROR64_GET_L(ec);
+    fields[4] = ERROR64_GET_N(ec), fields[5] = ERROR64_GET_A(ec), fields[6] = ERROR64_GET_U(ec);
+    err_sink_put( &s, k[0], strlen(k[0]) );
+    err_put_x64( hex, (uint64_t)ec );
+    err_sink_put( &s, hex, 16 );
+    for( i = 0; i < 7; ++i ) {
+        err_sink_put( &s, k[i + 1], strlen(k[i + 1]) );
+        err_sink_u32( &s, (uint32_t)fields[i] );
+    }
+    err_sink_put( &s, k[8], strlen(k[8]) );
+    err_parts( ec, 0, &parts );
+    for( i = 0; i < parts.count; ++i ) {
+        if( i ) err_sink_put( &s, " ", 1 );
+        err_sink_text( &s, parts.frag[i].ptr, parts.frag[i].len );
+    }
+    err_sink_put( &s, k[9], strlen(k[9]) );
+    if( s.full ) return (buf[0] = '\0', 0);
+    *s.p = '\0';
+    return (size_t)(s.p - buf);
+}
+
+size_t error64_to_json( char *buf, size_t cap, int64_t ec ) {
+    return err_emit( buf, cap, ec, ERROR64_JSON );
+}
+
+size_t error64_to_logfmt( char *buf, size_t cap, int64_t ec ) {
+    return err_emit( buf, cap, ec, ERROR64_LOGFMT );
+}
+
+void error64_writer_init( error64_writer *w, int format, size_t reserve ) {
+    w->data = reserve ? (char *)malloc( reserve ) : 0;
+    w->cap = w->data ? reserve : 0;
+    w->len = 0;
+    w->format = format;
+    if( w->data ) w->data[0] = '\0';
+}
+
+int error64_writer_append( error64_writer *w, int64_t ec ) {
+    for( ;; ) {
+        // record plus '\n' plus '\0'
+        size_t n = w->cap - w->len > 2 ? err_emit( w->data + w->len, w->cap - w->len - 1, ec, w->format ) : 0;
+        if( n ) {
+            w->len += n;
+            w->data[w->len++] = '\n';
+            w->data[w->len] = '\0';
+            return 1;
+        } else {
+            size_t cap = w->cap * 2 + 2048;
+            char *data = (char *)realloc( w->data, cap );
+            if( !data ) {
+                if( w->data ) w->data[w->len] = '\0';
+                return 0;
+            }
+            w->data = data, w->cap = cap;
+        }
+    }
+}
+
+void error64_writer_free( error64_writer *w ) {
+    free( w->data );
+    w->data = 0, w->len = w->cap = 0;
+}
+
+// Print error to a [cap] char buffer (extended info + site). Returns written length (truncated to cap-1, '\0' excluded)
+size_t strerror128ex_n( char *buf, size_t cap, error128_t ec ) {
+    char ext[64], *p = ext;
+    size_t at, k;
+    if( !cap ) return 0;
+    at = strerror64ex_n( buf, cap, ec.code );
+    ERR_PUT( p, " ; SITE_" ); p = err_put_x64( p, ec.site );
+    ERR_PUT( p, " file=" );   p = err_put_x32( p, ERROR128_GET_FILE(ec) );
+    ERR_PUT( p, ",line=" );   p = err_put_u32( p, ERROR128_GET_LINE(ec) );
+    k = (size_t)(p - ext) < cap - 1 - at ? (size_t)(p - ext) : cap - 1 - at;
+    memcpy( buf + at, ext, k );
+    at += k;
+    buf[at] = '\0';
+    return at;
+}
+
+// Print error to a [256] char buffer (extended info + site)
+const char *strerror128ex( char buf256[256], error128_t ec ) {
+    strerror128ex_n( buf256, 256, ec );
+    return buf256;
+}
+
+#ifdef ERROR64_CACHE
+typedef struct err_cache_entry { uint32_t key; uint32_t len; char text[56]; } err_cache_entry;
+static ERR_TLS(err_cache_entry) err_cache[ERROR64_CACHE_SIZE];
+static ERR_TLS(char) err_cache_long[256]; // messages that do not fit in an entry
+static ERR_TLS(unsigned) err_cache_gen;
+static ERR_TLS(uint64_t) err_cache_hits;
+static ERR_TLS(uint64_t) err_cache_misses;
+
+const char *strerror64_cached( int64_t ec, size_t *len ) {
+    uint32_t key = (uint32_t)((ec >> 32) & 0x7f000000) | (uint32_t)(ec & 0xffffff), slot, gen;
+    err_cache_entry *e;
+    size_t n;
+    if( ec >= 0 ) return (len ? *len = 0 : 0), "";
+#ifdef ERROR64_PRECOMPUTED_TABLE
+    {
+        const char *msg = err_table_lookup( ec, &n );
+        if( msg ) return (len ? *len = n : 0), msg;
+    }
+#endif
+    if( err_cache_gen != (gen = ERR_ATOMIC_ACQUIRE32( &err_glossary_gen )) ) {
+        memset( err_cache, 0, sizeof(err_cache) );
+        err_cache_gen = gen;
+    }
+    ++key; // 0 marks empty entries
+    slot = ((key * 2654435761u) >> 16) & (ERROR64_CACHE_SIZE - 1);
+    e = &err_cache[slot];
+    if( e->key == key ) {
+        ++err_cache_hits;
+        return (len ? *len = e->len : 0), e->text;
+    }
+    ++err_cache_misses;
+    n = strerror64_n( err_cache_long, sizeof(err_cache_long), ec );
+    if( n >= sizeof(e->text) ) {
+        return (len ? *len = n : 0), err_cache_long;
+    }
+    memcpy( e->text, err_cache_long, n + 1 );
+    e->len = (uint32_t)n;
+    e->key = key;
+    return (len ? *len = n : 0), e->text;
+}
+
+void error64_cache_stats( uint64_t *hits, uint64_t *misses ) {
+    if( hits ) *hits = err_cache_hits;
+    if( misses ) *misses = err_cache_misses;
+}
+#endif
+
+#ifdef ERROR64_STATS
+typedef struct err_stat_slot { uint32_t key; uint32_t pad; uint64_t count; } err_stat_slot;
+typedef struct err_stat_shard { err_stat_slot sites[ERROR64_STATS_SLOTS], descs[ERROR64_STATS_SLOTS]; } err_stat_shard;
+ERR_ALIGN(64) static err_stat_shard err_stats[ERROR64_STATS_SHARDS];
+static uint64_t err_stats_dropped;
+static uint64_t err_stats_threads;
+static ERR_TLS(int) err_stats_shard = -1;
+
+// Count key (never 0) in a shard table. Linear probing, claiming empty slots with a CAS
+static void err_stats_count( err_stat_slot *table, uint32_t key ) {
+    uint32_t i, slot = (key * 2654435761u) >> 7, k;
+    for( i = 0; i < 8; ++i ) {
+        err_stat_slot *s = &table[ (slot + i) & (ERROR64_STATS_SLOTS - 1) ];
+        k = ERR_ATOMIC_LOAD32( &s->key );
+        if( k == key || (!k && (ERR_ATOMIC_CAS32( &s->key, 0, key ) || ERR_ATOMIC_LOAD32( &s->key ) == key)) ) {
+            ERR_ATOMIC_ADD64( &s->count, 1 );
+            return;
+        }
+    }
+    ERR_ATOMIC_ADD64( &err_stats_dropped, 1 );
+}
+
+static void err_stats_raise( int64_t code ) {
+    err_stat_shard *shard;
+    if( err_stats_shard < 0 ) err_stats_shard = (int)(ERR_ATOMIC_ADD64( &err_stats_threads, 1 ) & (ERROR64_STATS_SHARDS - 1));
+    shard = &err_stats[ err_stats_shard ];
+    err_stats_count( shard->sites, (uint32_t)((ERROR64_GET_V(code) << 16) | ERROR64_GET_L(code)) + 1 );
+    err_stats_count( shard->descs, (uint32_t)(code & 0xffffff) + 1 );
+}
+
+static void err_stats_merge( error64_stat *out, size_t *num, size_t cap, int64_t key, uint64_t count ) {
+    size_t i;
+    for( i = 0; i < *num; ++i ) {
+        if( out[i].key == key ) { out[i].count += count; return; }
+    }
+    if( *num < cap ) {
+        out[*num].key = key, out[*num].count = count, ++*num;
+    }
+}
+
+uint64_t error64_stats_snapshot( error64_stat *sites, size_t *num_sites, error64_stat *descs, size_t *num_descs ) {
+    size_t cap_sites = *num_sites, cap_descs = *num_descs, s, i;
+    uint64_t count;
+    *num_sites = *num_descs = 0;
+    for( s = 0; s < ERROR64_STATS_SHARDS; ++s ) {
+        for( i = 0; i < ERROR64_STATS_SLOTS; ++i ) {
+            err_stat_slot *site = &err_stats[s].sites[i], *desc = &err_stats[s].descs[i];
+            uint32_t key;
+            if( (key = ERR_ATOMIC_LOAD32( &site->key )) != 0 && (count = ERR_ATOMIC_LOAD64( &site->count )) != 0 ) {
+                --key;
+                err_stats_merge( sites, num_sites, cap_sites, ERR_ERROR | ((int64_t)(key >> 16) << ERR_BIT_V) | ((int64_t)(key & 0xffff) << ERR_BIT_L), count );
+            }
+            if( (key = ERR_ATOMIC_LOAD32( &desc->key )) != 0 && (count = ERR_ATOMIC_LOAD64( &desc->count )) != 0 ) {
+                err_stats_merge( descs, num_descs, cap_descs, ERR_ERROR | (int64_t)(key - 1), count );
+            }
+        }
+    }
+    return ERR_ATOMIC_LOAD64( &err_stats_dropped );
+}
+#endif
+
+#ifdef ERROR64_SAMPLER
+// Bucket state packs { window (32 bits), count in window (32 bits) }, so counting is a single fetch-add
+typedef struct err_sampler_slot { uint64_t state; uint64_t suppressed; int64_t code; uint64_t pad; } err_sampler_slot;
+ERR_ALIGN(64) static err_sampler_slot err_sampler[ERROR64_SAMPLER_SLOTS];
+
+#ifndef ERROR64_SAMPLER_CLOCK
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#define ERROR64_SAMPLER_CLOCK() ( (uint64_t)GetTickCount64() )
+#else
+static uint64_t err_sampler_clock(void) {
+#   if defined(CLOCK_MONOTONIC_COARSE) // a vDSO read, no syscall
+    struct timespec ts; clock_gettime( CLOCK_MONOTONIC_COARSE, &ts );
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#   elif defined(CLOCK_MONOTONIC)
+    struct timespec ts; clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#   elif defined(TIME_UTC)
+    struct timespec ts; timespec_get( &ts, TIME_UTC );
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#   else
+    return (uint64_t)time(0) * 1000u;
+#   endif
+}
+#define ERROR64_SAMPLER_CLOCK() err_sampler_clock()
+#endif
+#endif
+
+// Book the overflow of a finished window. The code is published before the count, so flushes never report code 0
+static void err_sampler_book( err_sampler_slot *s, int64_t key, uint64_t count ) {
+    ERR_ATOMIC_STORE64( &s->code, key );
+    if( count > ERROR64_SAMPLER_BURST ) {
+        ERR_ATOMIC_FENCE();
+        ERR_ATOMIC_ADD64( &s->suppressed, count - ERROR64_SAMPLER_BURST );
+    }
+}
+
+int error64_should_report_at( int64_t ec, uint64_t now_ms ) {
+    int64_t key = ERR_ERROR | (ec & 0x7f0000ffffffffffLL); // api, line, descriptor
+    err_sampler_slot *s = &err_sampler[ ((uint64_t)key * 0x9E3779B97F4A7C15ull >> 32) & (ERROR64_SAMPLER_SLOTS - 1) ];
+    uint64_t window = (now_ms / ERROR64_SAMPLER_WINDOW_MS) & 0xffffffff, old = ERR_ATOMIC_ADD64( &s->state, 1 ) + 1;
+    for( ;; ) {
+        // current window, or a stale clock reading of another thread: count against the current window
+        if( (int32_t)(uint32_t)(window - (old >> 32)) <= 0 ) return (old & 0xffffffff) <= ERROR64_SAMPLER_BURST;
+        // first raise of a new window: restart the bucket, book the overflow of the finished window (minus this raise)
+        if( ERR_ATOMIC_CAS64( &s->state, old, window << 32 | 1 ) ) {
+            err_sampler_book( s, key, (old & 0xffffffff) - 1 );
+            return 1;
+        }
+        old = ERR_ATOMIC_LOAD64( &s->state );
+        if( (int32_t)(uint32_t)(window - (old >> 32)) <= 0 ) old = ERR_ATOMIC_ADD64( &s->state, 1 ) + 1;
+    }
+}
+
+int error64_should_report( int64_t ec ) {
+    return error64_should_report_at( ec, ERROR64_SAMPLER_CLOCK() );
+}
+
+size_t error64_sampler_flush_at( error64_sample *out, size_t cap, uint64_t now_ms ) {
+    uint64_t window = (now_ms / ERROR64_SAMPLER_WINDOW_MS) & 0xffffffff;
+    size_t i, n = 0;
+    for( i = 0; i < ERROR64_SAMPLER_SLOTS && n < cap; ++i ) {
+        err_sampler_slot *s = &err_sampler[i];
+        uint64_t count, old = ERR_ATOMIC_LOAD64( &s->state );
+        // window over and nothing raised since: close it, leaving the bucket at its budget (late raises still count)
+        if( (int32_t)(uint32_t)(window - (old >> 32)) > 0 && (old & 0xffffffff) > ERROR64_SAMPLER_BURST &&
+            ERR_ATOMIC_CAS64( &s->state, old, (old & ~0xffffffffull) | ERROR64_SAMPLER_BURST ) ) {
+            err_sampler_book( s, (int64_t)ERR_ATOMIC_LOAD64( &s->code ), old & 0xffffffff );
+        }
+        if( ERR_ATOMIC_LOAD64( &s->suppressed ) && (count = ERR_ATOMIC_XCHG64( &s->suppressed, 0 )) != 0 ) {
+            ERR_ATOMIC_FENCE();
+            out[n].code = (int64_t)ERR_ATOMIC_LOAD64( &s->code ), out[n].suppressed = count, ++n;
+        }
+    }
+    return n;
+}
+
+size_t error64_sampler_flush( error64_sample *out, size_t cap ) {
+    return error64_sampler_flush_at( out, cap, ERROR64_SAMPLER_CLOCK() );
+}
+#endif
+
+// Timestamps in nanoseconds since epoch (#define ERROR64_TIMESTAMP() to provide your own clock)
+#if defined(ERROR64_BINLOG) || defined(ERROR64_CHAIN) || defined(ERROR64_ASYNC)
+#include <time.h>
+#ifndef ERROR64_TIMESTAMP
+static uint64_t error64_timestamp(void) {
+#   if defined(CLOCK_REALTIME)
+    struct timespec ts; clock_gettime( CLOCK_REALTIME, &ts );
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#   elif defined(TIME_UTC)
+    struct timespec ts; timespec_get( &ts, TIME_UTC );
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#   else
+    return (uint64_t)time(0) * 1000000000ull;
+#   endif
+}
+#define ERROR64_TIMESTAMP() error64_timestamp()
+#endif
+#endif
+
+#ifdef ERROR64_CHAIN
+static ERR_TLS(error64_frame) err_chain[ERROR64_CHAIN_CAPACITY];
+static ERR_TLS(size_t) err_chain_used;
+
+static void err_chain_push( int64_t cause ) {
+    if( cause < 0 && err_chain_used < ERROR64_CHAIN_CAPACITY ) {
+        error64_frame *f = &err_chain[ err_chain_used++ ];
+        f->code = cause;
+        f->timestamp = ERROR64_TIMESTAMP();
+    }
+}
+
+void error64_chain_reset( void ) {
+    err_chain_used = 0;
+}
+
+size_t error64_chain( const error64_frame **frames ) {
+    *frames = err_chain;
+    return err_chain_used;
+}
+
+size_t error64_chain_print( FILE *fp, int64_t ec ) {
+    char buf256[256];
+    size_t i = err_chain_used;
+    fwrite( buf256, 1, strerror64ex_n( buf256, 256, ec ), fp );
+    fputc( '\n', fp );
+    while( i-- > 0 ) {
+        fputs( "  caused by: ", fp );
+        fwrite( buf256, 1, strerror64ex_n( buf256, 256, err_chain[i].code ), fp );
+        fputc( '\n', fp );
+    }
+    return err_chain_used;
+}
+#endif
+
+#ifdef ERROR64_SITES
+#if defined(_MSC_VER)
+#pragma section("error64_sites$a", read, write)
+#pragma section("error64_sites$z", read, write)
+__declspec(allocate("error64_sites$a")) static error64_site err_sites_begin[1];
+__declspec(allocate("error64_sites$z")) static error64_site err_sites_end[1];
+#define ERR_SITES_BEGIN ( err_sites_begin + 1 )
+#define ERR_SITES_END   ( err_sites_end )
+#elif defined(__APPLE__)
+extern error64_site err_sites_begin[] __asm("section$start$__DATA$error64_sites");
+extern error64_site err_sites_end[]   __asm("section$end$__DATA$error64_sites");
+#define ERR_SITES_BEGIN ( err_sites_begin )
+#define ERR_SITES_END   ( err_sites_end )
+#else
+// Weak, so that binaries without a single raise site still link
+extern error64_site __start_error64_sites[] __attribute__((weak));
+extern error64_site __stop_error64_sites[] __attribute__((weak));
+#define ERR_SITES_BEGIN ( __start_error64_sites )
+#define ERR_SITES_END   ( __stop_error64_sites )
+#endif
+
+static size_t err_sites_count = (size_t)-1;
+
+// Ascending codes; empty records (MSVC section padding) go last
+// By code, code 0 (runtime codes) last, then section padding (no file) after everything
+static int err_sites_compare( const void *a, const void *b ) {
+    uint64_t x = (uint64_t)((const error64_site *)a)->code - 1, y = (uint64_t)((const error64_site *)b)->code - 1;
+    int p = !((const error64_site *)a)->file, q = !((const error64_site *)b)->file;
+    return p != q ? p - q : x < y ? -1 : x > y;
+}
+
+size_t error64_site_list( const error64_site **sites ) {
+    if( err_sites_count == (size_t)-1 ) {
+        size_t n = ERR_SITES_BEGIN ? (size_t)(ERR_SITES_END - ERR_SITES_BEGIN) : 0;
+        qsort( ERR_SITES_BEGIN, n, sizeof(error64_site), err_sites_compare );
+        while( n && !ERR_SITES_BEGIN[n-1].file ) --n;
+        err_sites_count = n;
+    }
+    *sites = ERR_SITES_BEGIN;
+    return err_sites_count;
+}
+
+const error64_site *error64_site_find( int64_t code ) {
+    const error64_site *sites;
+    if( code >= 0 ) return 0; // not an error, or a runtime code record
+    size_t lo = 0, hi = error64_site_list( &sites );
+    while( lo < hi ) {
+        size_t mid = lo + (hi - lo) / 2;
+        if( (uint64_t)sites[mid].code - 1 < (uint64_t)code - 1 ) lo = mid + 1; else hi = mid;
+    }
+    return lo < err_sites_count && sites[lo].code == code ? &sites[lo] : 0;
+}
+#endif
+
+#ifdef ERROR64_SHM
+#include <errno.h>
+#ifdef _WIN32
+#include <windows.h>
+#define ERR_BOARD_YIELD()   SwitchToThread()
+#else
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__GLIBC__) && !defined(__USE_XOPEN_EXTENDED) && !defined(__USE_XOPEN2K)
+int ftruncate( int fd, off_t length ); // system headers came first, without POSIX feature macros
+#endif
+#define ERR_BOARD_YIELD()   sched_yield()
+#endif
+#define ERR_BOARD_WAITS     (1 << 20)                       // yields an opener waits for the creator to size and publish
+#define ERR_BOARD_KEY       ((int64_t)0xff00000000ffffffull) // error, api and descriptor
+
+// Process-local view of a mapping: the layout is validated once at open and never re-read from the segment
+struct error64_board {
+    error64_board_header *header; size_t size;
+    error64_board_slot *counters;
+    int64_t *recent;
+    uint32_t slots, ring;
+};
+static error64_board *err_board; // board raises are recorded into
+
+static size_t err_board_size( uint32_t slots, uint32_t ring ) {
+    return sizeof(error64_board_header) + (size_t)slots * sizeof(error64_board_slot) + (size_t)ring * sizeof(int64_t);
+}
+
+static uint32_t err_board_hash( int64_t key ) {
+    return (uint32_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+static void err_board_unmap( error64_board_header *h, size_t size ) {
+#ifdef _WIN32
+    (void)size, UnmapViewOfFile( h );
+#else
+    munmap( (void *)h, size );
+#endif
+}
+
+// Segments are zero-filled when created: only the creator writes the header, and publishes version last
+static void err_board_init( error64_board_header *h ) {
+    h->slots = ERROR64_SHM_SLOTS, h->ring = ERROR64_SHM_RING;
+    memcpy( h->magic, ERROR64_SHM_MAGIC, 8 );
+    ERR_ATOMIC_RELEASE32( &h->version, ERROR64_SHM_VERSION );
+}
+
+// Wait for the header to be published, then check it against the mapping size and cache the layout
+static error64_board *err_board_adopt( error64_board_header *h, size_t size ) {
+    error64_board *b;
+    uint32_t version = 0, slots, ring, i;
+    if( size < sizeof(*h) ) return 0;
+    for( i = 0; i < ERR_BOARD_WAITS && (version = ERR_ATOMIC_ACQUIRE32( &h->version )) == 0; ++i ) ERR_BOARD_YIELD();
+    if( version != ERROR64_SHM_VERSION || memcmp( h->magic, ERROR64_SHM_MAGIC, 8 ) ) return 0;
+    slots = h->slots, ring = h->ring;
+    if( !slots || (slots & (slots - 1)) || !ring || (ring & (ring - 1)) || (slots | ring) >> 24 ) return 0;
+    if( size < err_board_size( slots, ring ) || (b = (error64_board *)malloc( sizeof(*b) )) == 0 ) return 0;
+    b->header = h, b->size = size, b->slots = slots, b->ring = ring;
+    b->counters = (error64_board_slot *)(h + 1), b->recent = (int64_t *)(b->counters + slots);
+    return b;
+}
+
+error64_board *error64_board_open( const char *name ) {
+    size_t size = err_board_size( ERROR64_SHM_SLOTS, ERROR64_SHM_RING );
+    error64_board_header *h = 0;
+    error64_board *b;
+#ifdef _WIN32
+    // an existing mapping keeps its size: the view covers all of it (rounded up to pages)
+    HANDLE m = CreateFileMappingA( INVALID_HANDLE_VALUE, 0, PAGE_READWRITE, 0, (DWORD)size, name );
+    int created = m && GetLastError() != ERROR_ALREADY_EXISTS;
+    MEMORY_BASIC_INFORMATION info;
+    if( !m ) return 0;
+    h = (error64_board_header *)MapViewOfFile( m, FILE_MAP_ALL_ACCESS, 0, 0, 0 );
+    CloseHandle( m );
+    if( !h ) return 0;
+    if( created ) err_board_init( h );
+    else size = VirtualQuery( h, &info, sizeof(info) ) ? info.RegionSize : 0;
+#else
+    struct stat st;
+    int fd = shm_open( name, O_RDWR | O_CREAT | O_EXCL, ERROR64_SHM_MODE ), created = fd >= 0, i;
+    if( !created && errno == EEXIST ) fd = shm_open( name, O_RDWR, 0 );
+    if( fd < 0 ) return 0;
+    if( created ) {
+        // macOS refuses write() on shared memory objects: ftruncate() is the only portable way to size them
+        if( ftruncate( fd, (off_t)size ) < 0 ) size = 0;
+    } else {
+        // the creator may not have sized it yet
+        for( i = 0; !fstat( fd, &st ) && !st.st_size && i < ERR_BOARD_WAITS; ++i ) ERR_BOARD_YIELD();
+        size = !fstat( fd, &st ) ? (size_t)st.st_size : 0;
+    }
+    if( size ) {
+        h = (error64_board_header *)mmap( 0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        if( (void *)h == MAP_FAILED ) h = 0;
+    }
+    close( fd );
+    if( !h ) {
+        if( created ) shm_unlink( name ); // do not leave an unpublished segment behind for others to wait on
+        return 0;
+    }
+    if( created ) err_board_init( h );
+#endif
+    if( (b = err_board_adopt( h, size )) == 0 ) {
+        err_board_unmap( h, size );
+        return 0;
+    }
+    (void)ERR_ATOMIC_CASPTR( &err_board, 0, b );
+    return b;
+}
+
+void error64_board_close( error64_board *b ) {
+    if( !b ) return;
+    (void)ERR_ATOMIC_CASPTR( &err_board, b, 0 );
+    err_board_unmap( b->header, b->size );
+    free( b );
+}
+
+int error64_board_unlink( const char *name ) {
+#ifdef _WIN32
+    return (void)name, 0; // named mappings go away with their last handle
+#else
+    return shm_unlink( name );
+#endif
+}
+
+// Linear probing over a few slots, claiming empty ones with a CAS, as the ERROR64_STATS tables do
+static void err_board_raise( int64_t code ) {
+    const error64_board *b = (const error64_board *)ERR_ATOMIC_LOADPTR( &err_board );
+    int64_t key = code & ERR_BOARD_KEY, k;
+    uint32_t i, slot = err_board_hash( key );
+    if( !b ) return;
+    for( i = 0; i < 8; ++i ) {
+        error64_board_slot *s = &b->counters[ (slot + i) & (b->slots - 1) ];
+        k = (int64_t)ERR_ATOMIC_LOAD64( &s->key );
+        if( k == key || (!k && (ERR_ATOMIC_CAS64( &s->key, 0, key ) || (int64_t)ERR_ATOMIC_LOAD64( &s->key ) == key)) ) {
+            ERR_ATOMIC_ADD64( &s->count, 1 );
+            break;
+        }
+    }
+    if( i == 8 ) ERR_ATOMIC_ADD64( &b->header->dropped, 1 );
+    ERR_ATOMIC_STORE64( &b->recent[ ERR_ATOMIC_ADD64( &b->header->head, 1 ) & (b->ring - 1) ], code );
+}
+
+uint64_t error64_board_count( const error64_board *b, int64_t code ) {
+    int64_t key = code & ERR_BOARD_KEY, k;
+    uint32_t i, slot = err_board_hash( key );
+    for( i = 0; key && i < 8; ++i ) {
+        const error64_board_slot *s = &b->counters[ (slot + i) & (b->slots - 1) ];
+        if( (k = (int64_t)ERR_ATOMIC_LOAD64( &s->key )) == key ) return ERR_ATOMIC_LOAD64( &s->count );
+        if( !k ) break;
+    }
+    return 0;
+}
+
+size_t error64_board_recent( const error64_board *b, int64_t *out, size_t max ) {
+    uint64_t head = ERR_ATOMIC_LOAD64( &b->header->head );
+    size_t n;
+    for( n = 0; n < max && n < head && n < b->ring; ++n ) {
+        out[n] = (int64_t)ERR_ATOMIC_LOAD64( &b->recent[ (head - 1 - n) & (b->ring - 1) ] );
+    }
+    return n;
+}
+
+size_t error64_board_dump( FILE *fp, const error64_board *b ) {
+    uint64_t head = ERR_ATOMIC_LOAD64( &b->header->head ), n = head < b->ring ? head : b->ring, count;
+    size_t lines = 0;
+    uint32_t i;
+    char buf256[256];
+    for( i = 0; i < b->slots; ++i ) {
+        int64_t key = (int64_t)ERR_ATOMIC_LOAD64( &b->counters[i].key );
+        if( key && (count = ERR_ATOMIC_LOAD64( &b->counters[i].count )) != 0 ) {
+            fprintf( fp, "%12llu %s\n", (unsigned long long)count, strerror64ex( buf256, key ) ), ++lines;
+        }
+    }
+    if( (count = ERR_ATOMIC_LOAD64( &b->header->dropped )) != 0 ) fprintf( fp, "%12llu (not counted: board full)\n", (unsigned long long)count ), ++lines;
+    for( ; n; --n ) {
+        fprintf( fp, "recent: %s\n", strerror64ex( buf256, (int64_t)ERR_ATOMIC_LOAD64( &b->recent[ (head - 1) & (b->ring - 1) ] ) ) ), ++lines;
+        --head;
+    }
+    return lines;
+}
+#endif
+
+#ifdef ERROR64_ASYNC
+#include <fcntl.h>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#define ERR_ASYNC_WRITE(fd, p, n)   _write( fd, p, (unsigned)(n) )
+#define ERR_ASYNC_YIELD()           SwitchToThread()
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#define ERR_ASYNC_WRITE(fd, p, n)   write( fd, p, n )
+#define ERR_ASYNC_YIELD()           sched_yield()
+#endif
+// Bounded MPSC queue: cells carry sequence numbers, producers claim positions with a CAS (Vyukov)
+typedef struct err_async_cell { uint64_t seq; int64_t code; uint64_t timestamp; uint32_t thread, pad; } err_async_cell;
+static struct {
+    ERR_ALIGN(64) uint64_t tail;                    // next position to claim (producers)
+    ERR_ALIGN(64) uint64_t head;                    // next position to format (formatter)
+    ERR_ALIGN(64) uint64_t pushed, dropped, lost;   // lost: dropped codes not reported yet (ERROR64_ASYNC_COUNT)
+    uint64_t written, batches, max_depth, latency_sum, latency_max;
+    uint32_t sleeping, stopping, running, threads;
+    int fd, policy;
+    err_async_cell cells[ERROR64_ASYNC_QUEUE];
+} err_async;
+// Longest lines: "<sec>.<ns> T<thread> <message>\n" (20 + 13 + 255 + 1), and one "<sec>.<ns> error64: <n> codes dropped\n" (55)
+#define ERR_ASYNC_LINE      289
+#define ERR_ASYNC_LOST_LINE 64
+static char err_async_buf[ERROR64_ASYNC_BATCH * ERR_ASYNC_LINE + ERR_ASYNC_LOST_LINE]; // formatter thread only
+static ERR_TLS(uint32_t) err_async_thread;
+#ifdef _WIN32
+static SRWLOCK err_async_lock = SRWLOCK_INIT;
+static CONDITION_VARIABLE err_async_wake = CONDITION_VARIABLE_INIT;
+static HANDLE err_async_th;
+#else
+static pthread_mutex_t err_async_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t err_async_wake = PTHREAD_COND_INITIALIZER;
+static pthread_t err_async_th;
+#endif
+
+static void err_async_signal( void ) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive( &err_async_lock ); WakeConditionVariable( &err_async_wake ); ReleaseSRWLockExclusive( &err_async_lock );
+#else
+    pthread_mutex_lock( &err_async_lock ); pthread_cond_signal( &err_async_wake ); pthread_mutex_unlock( &err_async_lock );
+#endif
+}
+
+int error64_async_push( int64_t ec ) {
+    uint64_t pos = ERR_ATOMIC_LOAD64( &err_async.tail ), seq;
+    err_async_cell *c;
+    if( !ERR_ATOMIC_LOAD32( &err_async.running ) ) return 0;
+    if( !err_async_thread ) err_async_thread = (uint32_t)ERR_ATOMIC_ADD64( &err_async.threads, 1 ) + 1;
+    for( ;; ) {
+        c = &err_async.cells[ pos & (ERROR64_ASYNC_QUEUE - 1) ];
+        seq = ERR_ATOMIC_ACQUIRE64( &c->seq );
+        if( seq == pos ) {
+            if( ERR_ATOMIC_CAS64( &err_async.tail, pos, pos + 1 ) ) break;
+            pos = ERR_ATOMIC_LOAD64( &err_async.tail );
+        } else if( (int64_t)(seq - pos) < 0 ) { // full
+            if( err_async.policy != ERROR64_ASYNC_BLOCK ) {
+                ERR_ATOMIC_ADD64( &err_async.dropped, 1 );
+                if( err_async.policy == ERROR64_ASYNC_COUNT ) ERR_ATOMIC_ADD64( &err_async.lost, 1 );
+                return 0;
+            }
+            if( ERR_ATOMIC_LOAD32( &err_async.sleeping ) ) err_async_signal();
+            ERR_ASYNC_YIELD();
+            pos = ERR_ATOMIC_LOAD64( &err_async.tail );
+        } else {
+            pos = ERR_ATOMIC_LOAD64( &err_async.tail );
+        }
+    }
+    c->code = ec, c->timestamp = ERROR64_TIMESTAMP(), c->thread = err_async_thread;
+    ERR_ATOMIC_RELEASE64( &c->seq, pos + 1 );
+    ERR_ATOMIC_ADD64( &err_async.pushed, 1 );
+    // the formatter only sleeps after announcing it, so an idle formatter costs producers one fence, not a syscall
+    ERR_ATOMIC_FENCE();
+    if( ERR_ATOMIC_LOAD32( &err_async.sleeping ) ) err_async_signal();
+    return 1;
+}
+
+static int err_async_ready( uint64_t head ) {
+    return ERR_ATOMIC_ACQUIRE64( &err_async.cells[ head & (ERROR64_ASYNC_QUEUE - 1) ].seq ) == head + 1;
+}
+
+static char *err_async_stamp( char *p, uint64_t ns ) {
+    uint32_t frac = (uint32_t)(ns % 1000000000u), i;
+    p = err_put_u32( p, (uint32_t)(ns / 1000000000u) );
+    *p++ = '.';
+    for( i = 9; i-- > 0; frac /= 10 ) p[i] = (char)('0' + frac % 10);
+    return p + 9;
+}
+
+static void err_async_write( const char *p, size_t n ) {
+    while( n ) {
+        long w = (long)ERR_ASYNC_WRITE( err_async.fd, p, n );
+        if( w <= 0 ) return; // sink gone: drop the batch
+        p += w, n -= (size_t)w;
+    }
+}
+
+// Formatter thread: drain up to ERROR64_ASYNC_BATCH codes per write(), sleep when the queue is empty.
+// Only this thread writes head and the latency/depth metrics
+static void err_async_run( void ) {
+    uint64_t head = err_async.head, max_depth = 0, latency_sum = 0, latency_max = 0;
+    for( ;; ) {
+        char *p = err_async_buf;
+        uint64_t lost = ERR_ATOMIC_LOAD64( &err_async.lost ) ? ERR_ATOMIC_XCHG64( &err_async.lost, 0 ) : 0, now, n = 0;
+        uint64_t waited = 0, oldest = 0, done; // queue time of the batch until now (sum, max)
+        uint64_t depth = ERR_ATOMIC_LOAD64( &err_async.tail ) - head;
+        if( depth > max_depth ) ERR_ATOMIC_STORE64( &err_async.max_depth, max_depth = depth );
+        now = ERROR64_TIMESTAMP();
+        if( lost ) {
+            p = err_async_stamp( p, now );
+            ERR_PUT( p, " error64: " ); p = err_put_u32( p, (uint32_t)(lost > 0xffffffffu ? 0xffffffffu : lost) );
+            ERR_PUT( p, " codes dropped\n" );
+        }
+        for( ; n < ERROR64_ASYNC_BATCH && err_async_ready( head ); ++n, ++head ) {
+            err_async_cell *c = &err_async.cells[ head & (ERROR64_ASYNC_QUEUE - 1) ];
+            uint64_t age = now > c->timestamp ? now - c->timestamp : 0;
+            waited += age;
+            if( age > oldest ) oldest = age;
+            p = err_async_stamp( p, c->timestamp );
+            ERR_PUT( p, " T" ); p = err_put_u32( p, c->thread ); *p++ = ' ';
+            p += strerror64ex_n( p, 256, c->code );
+            *p++ = '\n';
+            ERR_ATOMIC_RELEASE64( &c->seq, head + ERROR64_ASYNC_QUEUE );
+        }
+        if( p != err_async_buf ) {
+            err_async_write( err_async_buf, (size_t)(p - err_async_buf) );
+            // latency runs from push to the end of write()
+            done = ERROR64_TIMESTAMP();
+            done = done > now ? done - now : 0;
+            latency_sum += waited + done * n;
+            if( n && oldest + done > latency_max ) latency_max = oldest + done;
+            ERR_ATOMIC_STORE64( &err_async.head, head );
+            ERR_ATOMIC_STORE64( &err_async.latency_sum, latency_sum );
+            ERR_ATOMIC_STORE64( &err_async.latency_max, latency_max );
+            ERR_ATOMIC_ADD64( &err_async.written, n );
+            ERR_ATOMIC_ADD64( &err_async.batches, 1 );
+            continue;
+        }
+        if( ERR_ATOMIC_LOAD32( &err_async.stopping ) ) return;
+        // announce, then re-check: a producer either sees sleeping set, or its code is seen here
+#ifdef _WIN32
+        AcquireSRWLockExclusive( &err_async_lock );
+#else
+        pthread_mutex_lock( &err_async_lock );
+#endif
+        ERR_ATOMIC_STORE32( &err_async.sleeping, 1 );
+        ERR_ATOMIC_FENCE();
+        if( !err_async_ready( head ) && !ERR_ATOMIC_LOAD32( &err_async.stopping ) ) {
+#ifdef _WIN32
+            SleepConditionVariableSRW( &err_async_wake, &err_async_lock, INFINITE, 0 );
+#else
+            pthread_cond_wait( &err_async_wake, &err_async_lock );
+#endif
+        }
+        ERR_ATOMIC_STORE32( &err_async.sleeping, 0 );
+#ifdef _WIN32
+        ReleaseSRWLockExclusive( &err_async_lock );
+#else
+        pthread_mutex_unlock( &err_async_lock );
+#endif
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI err_async_thread_main( LPVOID arg ) { (void)arg; err_async_run(); return 0; }
+#else
+static void *err_async_thread_main( void *arg ) { (void)arg; err_async_run(); return 0; }
+#endif
+
+int error64_async_start( int fd, int policy ) {
+    uint64_t i;
+    if( ERR_ATOMIC_LOAD32( &err_async.running ) ) return -1;
+    err_async.tail = err_async.head = 0;
+    err_async.pushed = err_async.dropped = err_async.lost = err_async.written = err_async.batches = 0;
+    err_async.max_depth = err_async.latency_sum = err_async.latency_max = 0;
+    for( i = 0; i < ERROR64_ASYNC_QUEUE; ++i ) err_async.cells[i].seq = i;
+    err_async.fd = fd, err_async.policy = policy, err_async.stopping = 0;
+#ifdef _WIN32
+    if( (err_async_th = CreateThread( 0, 0, err_async_thread_main, 0, 0, 0 )) == 0 ) return -1;
+#else
+    if( pthread_create( &err_async_th, 0, err_async_thread_main, 0 ) ) return -1;
+#endif
+    ERR_ATOMIC_STORE32( &err_async.running, 1 );
+    return 0;
+}
+
+void error64_async_stop( void ) {
+    if( !ERR_ATOMIC_LOAD32( &err_async.running ) ) return;
+    ERR_ATOMIC_STORE32( &err_async.running, 0 );
+    ERR_ATOMIC_STORE32( &err_async.stopping, 1 );
+    err_async_signal();
+#ifdef _WIN32
+    WaitForSingleObject( err_async_th, INFINITE );
+    CloseHandle( err_async_th );
+#else
+    pthread_join( err_async_th, 0 );
+#endif
+}
+
+void error64_async_metrics( error64_async_stats *s ) {
+    uint64_t head = ERR_ATOMIC_LOAD64( &err_async.head ), tail = ERR_ATOMIC_LOAD64( &err_async.tail );
+    s->pushed = ERR_ATOMIC_LOAD64( &err_async.pushed ), s->dropped = ERR_ATOMIC_LOAD64( &err_async.dropped );
+    s->written = ERR_ATOMIC_LOAD64( &err_async.written ), s->batches = ERR_ATOMIC_LOAD64( &err_async.batches );
+    s->depth = tail > head ? tail - head : 0, s->max_depth = ERR_ATOMIC_LOAD64( &err_async.max_depth );
+    s->latency_avg_ns = s->written ? ERR_ATOMIC_LOAD64( &err_async.latency_sum ) / s->written : 0;
+    s->latency_max_ns = ERR_ATOMIC_LOAD64( &err_async.latency_max );
+}
+#endif
+
+#ifdef ERROR64_TRACE
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#include <pthread.h>
+#if defined(__GLIBC__) && !defined(__USE_GNU)
+int pthread_getattr_np( pthread_t thread, pthread_attr_t *attr ); // declared for _GNU_SOURCE only
+#endif
+#if defined(__GLIBC__) && !defined(__USE_XOPEN2K)
+int pthread_attr_getstack( const pthread_attr_t *attr, void **addr, size_t *size );
+#endif
+#endif
+typedef struct err_trace_slot { int64_t code; size_t depth; void *frames[ERROR64_TRACE_DEPTH]; } err_trace_slot;
+static ERR_TLS(err_trace_slot) err_traces[ERROR64_TRACE_SLOTS];
+static ERR_TLS(uint32_t) err_trace_head;
+
+#ifndef ERROR64_TRACE_CAPTURE
+#if !defined(_MSC_VER) || defined(__clang__)
+static ERR_TLS(uintptr_t) err_trace_stack; // top of this thread's stack (1: unknown, 0: not looked up yet)
+
+// Top (highest address) of the calling thread's stack, looked up once per thread. Frames are only read below it
+static uintptr_t err_trace_stack_top( void ) {
+    if( !err_trace_stack ) {
+        uintptr_t top = 1;
+#if defined(_WIN32)
+        top = (uintptr_t)((NT_TIB *)NtCurrentTeb())->StackBase;
+#elif defined(__GLIBC__)
+        pthread_attr_t attr;
+        void *addr;
+        size_t size;
+        if( !pthread_getattr_np( pthread_self(), &attr ) ) {
+            if( !pthread_attr_getstack( &attr, &addr, &size ) ) top = (uintptr_t)addr + size;
+            pthread_attr_destroy( &attr );
+        }
+#elif defined(__APPLE__)
+        top = (uintptr_t)pthread_get_stackaddr_np( pthread_self() );
+#endif
+        err_trace_stack = top;
+    }
+    return err_trace_stack;
+}
+#endif
+
+// Return addresses of the raise site (caller: error64_raise()'s return address) and its callers.
+// GCC/Clang walk { saved frame pointer, return address } pairs (x86, x86-64, ARM64) up the current thread's stack, skipping
+// err_trace_raise() and error64_raise(). The walk is kept only if it reaches caller: without frame pointers it does not,
+// and backtrace() (glibc, Apple) or else caller alone is used instead.
+static ERR_NOINLINE size_t err_trace_capture( void **frames, size_t max, void *caller ) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return (void)caller, RtlCaptureStackBackTrace( 3, (DWORD)max, frames, 0 );
+#else
+    uintptr_t top = err_trace_stack_top(), fp = (uintptr_t)__builtin_frame_address( 0 ), next;
+    size_t n = 0;
+    int skip = 2;
+    while( n < max && fp + 2 * sizeof(void *) <= top && !(fp & (sizeof(void *) - 1)) ) {
+        void *ret = ((void **)fp)[1];
+        if( !ret || ((uintptr_t)ret < top && (uintptr_t)ret >= fp) ) break; // return addresses do not point into the stack
+        if( skip ) --skip; else if( (frames[n++] = ret) != caller && n == 1 ) break;
+        if( (next = (uintptr_t)((void **)fp)[0]) <= fp ) break;
+        fp = next;
+    }
+    if( n && frames[0] == caller ) return n;
+#if defined(__GLIBC__) || defined(__APPLE__)
+    {
+        void *all[ERROR64_TRACE_DEPTH + 8];
+        int i, got = backtrace( all, (int)(sizeof(all) / sizeof(all[0])) );
+        for( i = 0; i < got && i < 8; ++i ) {
+            if( all[i] != caller ) continue;
+            for( n = 0; n < max && i < got; ) frames[n++] = all[i++];
+            return n;
+        }
+    }
+#endif
+    return max ? (frames[0] = caller, 1) : 0;
+#endif
+}
+#endif
+
+static ERR_NOINLINE void err_trace_raise( int64_t code, void *caller ) {
+    err_trace_slot *s = &err_traces[ err_trace_head++ & (ERROR64_TRACE_SLOTS - 1) ];
+    s->code = code;
+#ifdef ERROR64_TRACE_CAPTURE
+    (void)caller;
+    s->depth = ERROR64_TRACE_CAPTURE( s->frames, ERROR64_TRACE_DEPTH );
+#else
+    s->depth = err_trace_capture( s->frames, ERROR64_TRACE_DEPTH, caller );
+#endif
+}
+
+size_t error64_trace( int64_t code, void **frames, size_t max ) {
+    uint32_t i, n = err_trace_head < ERROR64_TRACE_SLOTS ? err_trace_head : ERROR64_TRACE_SLOTS;
+    for( i = 1; i <= n; ++i ) {
+        const err_trace_slot *s = &err_traces[ (err_trace_head - i) & (ERROR64_TRACE_SLOTS - 1) ];
+        if( s->code == code ) {
+            size_t depth = s->depth < max ? s->depth : max;
+            memcpy( frames, s->frames, depth * sizeof(void *) );
+            return depth;
+        }
+    }
+    return 0;
+}
+
+size_t error64_trace_print( FILE *fp, int64_t code ) {
+    void *frames[ERROR64_TRACE_DEPTH];
+    size_t n = error64_trace( code, frames, ERROR64_TRACE_DEPTH ), i;
+    char buf256[256];
+#if defined(__GLIBC__) || defined(__APPLE__)
+    char **names = n ? backtrace_symbols( frames, (int)n ) : 0;
+#endif
+    fwrite( buf256, 1, strerror64ex_n( buf256, 256, code ), fp );
+    fputc( '\n', fp );
+    for( i = 0; i < n; ++i ) {
+#if defined(__GLIBC__) || defined(__APPLE__)
+        if( names ) { fprintf( fp, "  #%u %s\n", (unsigned)i, names[i] ); continue; }
+#endif
+        fprintf( fp, "  #%u %p\n", (unsigned)i, frames[i] );
+    }
+#if defined(__GLIBC__) || defined(__APPLE__)
+    free( names );
+#endif
+    return n;
+}
+#endif
+
+#if defined(ERROR64_STATS) || defined(ERROR64_CHAIN) || defined(ERROR64_SHM) || defined(ERROR64_TRACE)
+// Out of line, so that traces can skip a known number of frames
+ERR_NOINLINE int64_t error64_raise( int64_t code, int64_t cause ) {
+#ifdef ERROR64_STATS
+    err_stats_raise( code );
+#endif
+#ifdef ERROR64_SHM
+    err_board_raise( code );
+#endif
+#ifdef ERROR64_TRACE
+#if defined(_MSC_VER) && !defined(__clang__)
+    err_trace_raise( code, _ReturnAddress() );
+#else
+    err_trace_raise( code, __builtin_return_address( 0 ) );
+#endif
+#endif
+#ifdef ERROR64_CHAIN
+    err_chain_push( cause );
+#endif
+    (void)cause;
+    return code;
+}
+#endif
+
+#ifdef ERROR64_BINLOG
+
+typedef struct err_log_ring {
+    struct err_log_ring *next;      // global list, push-only
+    uint32_t owned, id;             // owned by a live thread; registration order
+    uint64_t head;                  // records written so far, published with release order
+    error64_record recs[ERROR64_BINLOG_CAPACITY];
+} err_log_ring;
+
+static err_log_ring *err_log_rings;
+static uint32_t err_log_ring_count;
+static ERR_TLS(err_log_ring *) err_log_self;
+
+// First log of a thread: adopt a detached ring, or allocate and push a new one. Rarely taken
+static ERR_NOINLINE err_log_ring *err_log_attach( void ) {
+    err_log_ring *r;
+    for( r = (err_log_ring *)ERR_ATOMIC_LOADPTR( &err_log_rings ); r; r = r->next ) {
+        if( !ERR_ATOMIC_LOAD32( &r->owned ) && ERR_ATOMIC_CAS32( &r->owned, 0, 1 ) ) {
+            ERR_ATOMIC_RELEASE64( &r->head, 0 );
+            return err_log_self = r;
+        }
+    }
+    if( (r = (err_log_ring *)calloc( 1, sizeof(err_log_ring) )) == 0 ) return 0;
+    r->owned = 1, r->id = ERR_ATOMIC_ADD32( &err_log_ring_count, 1 );
+    do r->next = (err_log_ring *)ERR_ATOMIC_LOADPTR( &err_log_rings ); while( !ERR_ATOMIC_CASPTR( &err_log_rings, r->next, r ) );
+    return err_log_self = r;
+}
+
+int64_t error64_log( int64_t code ) {
+    err_log_ring *r = err_log_self ? err_log_self : err_log_attach();
+    if( r ) {
+        uint64_t head = r->head;
+        error64_record *rec = &r->recs[ head & (ERROR64_BINLOG_CAPACITY - 1) ];
+        rec->timestamp = ERROR64_TIMESTAMP();
+        rec->code = code;
+        ERR_ATOMIC_RELEASE64( &r->head, head + 1 );
+    }
+    return code;
+}
+
+// Copy the newest max records of a ring, oldest first. Records the owner overwrote during the copy are dropped
+static size_t err_log_copy( err_log_ring *r, error64_record *out, size_t max ) {
+    uint64_t head = ERR_ATOMIC_ACQUIRE64( &r->head ), n = head < ERROR64_BINLOG_CAPACITY ? head : ERROR64_BINLOG_CAPACITY, i, now;
+    if( n > max ) n = max;
+    for( i = 0; i < n; ++i ) {
+        out[i] = r->recs[ (head - n + i) & (ERROR64_BINLOG_CAPACITY - 1) ];
+    }
+    ERR_ATOMIC_FENCE();
+    // meanwhile the owner may be writing record #now, over record #(now - CAPACITY): that one and older ones are suspect
+    now = ERR_ATOMIC_ACQUIRE64( &r->head );
+    if( now + n >= head + ERROR64_BINLOG_CAPACITY ) {
+        uint64_t drop = now + n + 1 - head - ERROR64_BINLOG_CAPACITY;
+        if( drop > n ) drop = n;
+        memmove( out, out + drop, (size_t)(n - drop) * sizeof(error64_record) );
+        n -= drop;
+    }
+    return (size_t)n;
+}
+
+size_t error64_log_dump( error64_record *out, size_t max ) {
+    return err_log_self ? err_log_copy( err_log_self, out, max ) : 0;
+}
+
+size_t error64_log_dump_all( error64_record *out, size_t max, error64_log_visitor fn, void *user ) {
+    err_log_ring *r;
+    size_t rings = 0;
+    for( r = (err_log_ring *)ERR_ATOMIC_LOADPTR( &err_log_rings ); r; r = r->next, ++rings ) {
+        size_t n = err_log_copy( r, out, max );
+        if( fn ) fn( (int)r->id, out, n, user );
+    }
+    return rings;
+}
+
+void error64_log_detach( void ) {
+    if( err_log_self ) ERR_ATOMIC_RELEASE32( &err_log_self->owned, 0 ), err_log_self = 0;
+}
+
+size_t error64_log_save( FILE *fp ) {
+    err_log_ring *r = err_log_self;
+    uint64_t head = r ? r->head : 0, n = head < ERROR64_BINLOG_CAPACITY ? head : ERROR64_BINLOG_CAPACITY;
+    size_t from = (size_t)((head - n) & (ERROR64_BINLOG_CAPACITY - 1)), tail = ERROR64_BINLOG_CAPACITY - from;
+    if( !n ) return 0;
+    if( tail >= n ) return fwrite( &r->recs[from], sizeof(error64_record), (size_t)n, fp );
+    tail = fwrite( &r->recs[from], sizeof(error64_record), tail, fp );
+    return tail + fwrite( &r->recs[0], sizeof(error64_record), (size_t)n - tail, fp );
+}
+
+size_t error64_log_decode( FILE *fp, const error64_record *recs, size_t n ) {
+    char buf256[256];
+    size_t i;
+    for( i = 0; i < n; ++i ) {
+        char *p = buf256 + 20;
+        uint64_t ts = recs[i].timestamp;
+        do *--p = (char)('0' + ts % 10); while( ts /= 10 );
+        fwrite( p, 1, (size_t)(buf256 + 20 - p), fp );
+        fputc( ' ', fp );
+        fwrite( buf256, 1, strerror64ex_n( buf256, 256, recs[i].code ), fp );
+        fputc( '\n', fp );
+    }
+    return n;
+}
+#endif
+
+// Function that resolve the glossary enums (nouns) above
+#ifndef ERROR64_USER_DEFINED_GLOSSARY
+const char *glossary( int enumeration ) {
+    int count = (int)(sizeof(err_noun_names) / sizeof(err_noun_names[0]));
+    return enumeration >= 0 && enumeration < count ? err_noun_names[enumeration] : "??";
+}
+#endif
+
+#endif // ERROR64_DEFINE_IMPLEMENTATION
+
+#ifdef __cplusplus
+}
+#endif
+
+// C++17 compile-time messages: error64::message<ERROR64(NN_DISK | ERR_FULL)>() is a std::string_view into static storage.
+// Nouns come from a glossary type with a `static constexpr std::string_view noun(int)` member (error64::nouns by default).
+#if defined(__cplusplus) && ( __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) )
+#include <assert.h>
+#include <atomic>
+#include <new>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+namespace error64 {
+#   define ERR_SV(n, id, str) std::string_view(str),
+    inline constexpr std::string_view attributes[256] = { "", ERR_ATTRIBUTES(ERR_SV) };
+#   undef ERR_SV
+
+#ifndef ERROR64_USER_DEFINED_GLOSSARY
+    struct nouns {
+#       define ERR_SV(id, str) std::string_view(str),
+        static constexpr std::string_view names[] = { "", ERR_NOUNS(ERR_SV) };
+#       undef ERR_SV
+        static constexpr std::string_view noun( int u ) {
+            return u < int(sizeof(names) / sizeof(names[0])) ? names[u] : "??";
+        }
+    };
+#else
+    struct nouns; // user-provided
+#endif
+
+    struct fragments { std::string_view v[3]; };
+    constexpr fragments split( int64_t ec, std::string_view noun ) {
+        std::string_view neg = ( ec & ERR_NOT ) ? "NOT" : "", adj = attributes[ (ec >> ERR_BIT_A) & 0xff ];
+        int64_t type = ec & (0x1ffLL << ERR_BIT_A);
+        bool special = (type == ERR_A)  || (type == ERR_NOT_A) ||
+                       (type == ERR_NO) || (type == ERR_NO_SUCH) ||
+                       (type == ERR_ENOUGH) || (type == ERR_NOT_ENOUGH);
+        return ec >= 0 ? fragments{{ "", "", "" }} : special ? fragments{{ neg, adj, noun }} : fragments{{ noun, neg, adj }};
+    }
+    constexpr size_t length( const fragments &f ) {
+        size_t n = 0;
+        for( std::string_view s : f.v ) if( !s.empty() ) n += (n ? 1 : 0) + s.size();
+        return n;
+    }
+
+    template<int64_t ec, typename G>
+    struct text {
+        static constexpr fragments parts = split( ec, G::noun( int(ec & 0x7fff) ) );
+        static constexpr size_t size = length( parts );
+        struct storage { char data[size + 1]; };
+        static constexpr storage make() {
+            storage s{};
+            size_t n = 0;
+            for( std::string_view v : parts.v ) {
+                if( v.empty() ) continue;
+                if( n ) s.data[n++] = ' ';
+                for( char c : v ) s.data[n++] = c;
+            }
+            return s;
+        }
+        static constexpr storage str = make();
+    };
+
+    template<int64_t ec, typename G = nouns>
+    constexpr std::string_view message() {
+        return std::string_view( text<ec, G>::str.data, text<ec, G>::size );
+    }
+
+    // co_await error64::carry( awaiter ): errno64 survives the suspension point, even if the coroutine resumes on another thread
+    template<typename A>
+    struct carry_awaiter {
+        A inner;
+        int64_t saved;
+        bool await_ready() { saved = errno64; return inner.await_ready(); }
+        template<typename H> decltype(auto) await_suspend( H h ) { return inner.await_suspend( h ); }
+        decltype(auto) await_resume() { errno64 = saved; return inner.await_resume(); }
+    };
+    template<typename A>
+    carry_awaiter<A> carry( A &&a ) {
+        return carry_awaiter<A>{ static_cast<A &&>( a ), 0 };
+    }
+
+    // error64::result<T>: a T or an error code, returned by value instead of through errno64 or exceptions. No heap.
+    // The error bit (ERR_BIT_E) is the discriminant: integers/enums up to 32 bits and pointers (user-space, top bit clear)
+    // pack into the same int64_t as the code, so result<int32_t> or result<T*> travels in one register.
+    // Move-only and [[nodiscard]]. value() of a failed result asserts.
+    struct failure { int64_t code; };
+    constexpr failure fail( int64_t code ) { return failure{ code | ERR_ERROR }; }
+    // return ERROR64_FAIL(NN_FILE | ERR_MISSING); runs the raise hooks (ERROR64_STATS, ERROR64_SITES) but leaves errno64 alone
+#   define ERROR64_FAIL(x) error64::fail( ERR_RAISE_HOOK( ERROR64_SITE(x), 0 ) )
+
+    template<typename T, typename = void>
+    struct result_packing : std::false_type {};
+    template<typename T>
+    struct result_packing<T, std::enable_if_t< (std::is_integral_v<T> || std::is_enum_v<T>) && sizeof(T) <= 4 >> : std::true_type {
+        static constexpr int64_t pack( T v ) { return int64_t( static_cast<uint32_t>( v ) ); }
+        static constexpr T unpack( int64_t bits ) { return static_cast<T>( uint32_t( bits ) ); }
+    };
+    template<typename T>
+    struct result_packing<T *> : std::true_type {
+        static int64_t pack( T *p ) { return assert( int64_t( reinterpret_cast<uintptr_t>( p ) ) >= 0 ), int64_t( reinterpret_cast<uintptr_t>( p ) ); }
+        static T *unpack( int64_t bits ) { return reinterpret_cast<T *>( uintptr_t( bits ) ); }
+    };
+
+    // Packed: one int64_t, >= 0 holds the value, < 0 is the error code
+    template<typename T, bool packed = result_packing<T>::value>
+    class [[nodiscard]] result {
+        int64_t bits;
+    public:
+        constexpr result( T v ) : bits( result_packing<T>::pack( v ) ) {}
+        constexpr result( failure f ) : bits( f.code ) {}
+        result( result && ) = default;
+        result &operator=( result && ) = default;
+        result( const result & ) = delete;
+        result &operator=( const result & ) = delete;
+
+        constexpr bool ok() const { return bits >= 0; }
+        constexpr explicit operator bool() const { return bits >= 0; }
+        constexpr int64_t error() const { return bits < 0 ? bits : 0; }
+        constexpr T value() const { return assert( bits >= 0 ), result_packing<T>::unpack( bits ); }
+        constexpr T operator*() const { return value(); }
+        constexpr T value_or( T v ) const { return bits >= 0 ? result_packing<T>::unpack( bits ) : v; }
+    };
+
+    // Unpacked: the error code next to the storage of T (int64_t code = 0 while a value is held)
+    template<typename T>
+    class [[nodiscard]] result<T, false> {
+        int64_t code;
+        union { T val; };
+    public:
+        result( T v ) : code( 0 ), val( std::move( v ) ) {}
+        result( failure f ) : code( f.code ) {}
+        result( result &&r ) noexcept( std::is_nothrow_move_constructible_v<T> ) : code( r.code ) {
+            if( code >= 0 ) new (&val) T( std::move( r.val ) );
+        }
+        result &operator=( result &&r ) noexcept( std::is_nothrow_move_constructible_v<T> ) {
+            if( this != &r ) {
+                if( code >= 0 ) val.~T();
+                code = r.code;
+                if( code >= 0 ) new (&val) T( std::move( r.val ) );
+            }
+            return *this;
+        }
+        result( const result & ) = delete;
+        result &operator=( const result & ) = delete;
+        ~result() { if( code >= 0 ) val.~T(); }
+
+        bool ok() const { return code >= 0; }
+        explicit operator bool() const { return code >= 0; }
+        int64_t error() const { return code < 0 ? code : 0; }
+        T &value() & { return assert( code >= 0 ), val; }
+        const T &value() const & { return assert( code >= 0 ), val; }
+        T &&value() && { return assert( code >= 0 ), std::move( val ); }
+        T &operator*() & { return value(); }
+        const T &operator*() const & { return value(); }
+        T &&operator*() && { return std::move( *this ).value(); }
+        T *operator->() { return &value(); }
+        const T *operator->() const { return &value(); }
+        T value_or( T v ) const & { return code >= 0 ? val : v; }
+    };
+
+    // Success carries no value: result<void> is just the code
+    template<>
+    class [[nodiscard]] result<void, false> {
+        int64_t code;
+    public:
+        constexpr result() : code( 0 ) {}
+        constexpr result( failure f ) : code( f.code ) {}
+        result( result && ) = default;
+        result &operator=( result && ) = default;
+        result( const result & ) = delete;
+        result &operator=( const result & ) = delete;
+
+        constexpr bool ok() const { return code >= 0; }
+        constexpr explicit operator bool() const { return code >= 0; }
+        constexpr int64_t error() const { return code < 0 ? code : 0; }
+    };
+
+    // std::error_code integration. The int value is the 24-bit descriptor (N+A+U) plus bit 24, so errors never map to 0.
+    // The api (V) picks one of 128 categories, since every api may have its own glossary. rev and line do not fit:
+    // make_error_code() keeps the latest full code of each api + descriptor in a process-wide lock-free table, so
+    // to_error64() recovers rev/line on any thread (e.g. in an asio completion handler). Limits: two live codes that only
+    // differ in rev/line share an entry (the latest raise wins), and table collisions fall back to api + descriptor.
+    // message() copies interned text: strerror64_cached() (ERROR64_CACHE) or a per-thread buffer. No formatting allocations.
+    struct category final : std::error_category {
+        static const category *all() { static const category c[128]{}; return c; }
+        int api() const { return int( this - all() ); }
+        const char *name() const noexcept override { return "error64"; }
+        std::string message( int value ) const override {
+            int64_t ec = value & 0x1000000 ? ERR_ERROR | ( int64_t( api() ) << ERR_BIT_V ) | ( value & 0xffffff ) : 0;
+#ifdef ERROR64_CACHE
+            size_t len;
+            const char *text = strerror64_cached( ec, &len );
+#else
+            static thread_local char text[256];
+            size_t len = strerror64_n( text, 256, ec );
+#endif
+            return std::string( text, len );
+        }
+    };
+    // Slot of an api + descriptor key (the code without rev and line)
+    inline std::atomic<int64_t> locators[4096] = {};
+    inline std::atomic<int64_t> &locator( int64_t key ) {
+        return locators[ ( uint64_t( key ) * 0x9E3779B97F4A7C15ull ) >> 52 ];
+    }
+    constexpr int64_t locator_mask = ~( 0xffffLL << ERR_BIT_R | 0xffffLL << ERR_BIT_L );
+
+    inline std::error_code make_error_code( int64_t ec ) {
+        int value = int( ( ec & 0xffffff ) | 0x1000000 );
+        if( ec >= 0 ) return std::error_code();
+        locator( ec & locator_mask ).store( ec, std::memory_order_relaxed );
+        return std::error_code( value, category::all()[ ERROR64_GET_V(ec) ] );
+    }
+    // error64 code of an error64 std::error_code: full code if the locator table still has it, else api + descriptor only.
+    // Returns 0 for success and for other categories (identified by address: no RTTI needed)
+    inline int64_t to_error64( const std::error_code &e ) {
+        uintptr_t at = uintptr_t( &e.category() ) - uintptr_t( category::all() );
+        int64_t ec, full;
+        if( !e || at >= 128 * sizeof(category) || at % sizeof(category) ) return 0;
+        ec = ERR_ERROR | ( int64_t( at / sizeof(category) ) << ERR_BIT_V ) | ( e.value() & 0xffffff );
+        full = locator( ec ).load( std::memory_order_relaxed );
+        return ( full & locator_mask ) == ec ? full : ec;
+    }
+}
+
+// Category of api's error codes (api 0 by default)
+inline const std::error_category &error64_category( int api = 0 ) {
+    return error64::category::all()[ api & 0x7f ];
+}
+#endif
+
+#endif // ERROR64_H
+
+#ifdef ERROR64_BUILD_DEMO
+
+// Our sample
+#include <assert.h>
+#include <string.h>
+#if defined(__cplusplus) && __cplusplus >= 201703L
+#include <thread>
+#endif
+
+#ifdef ERROR64_BINLOG
+// worker thread for error64_log_dump_all(): logs into its own ring, then exits without detaching
+static int64_t demo_log_codes[2];
+static void demo_log_work( void ) {
+    demo_log_codes[0] = ERROR64_LOG(NN_NETWORK | ERR_TIMED_OUT);
+    demo_log_codes[1] = ERROR64_LOG(NN_FILE | ERR_NOT_FOUND);
+}
+#ifdef _WIN32
+static DWORD WINAPI demo_log_worker( LPVOID arg ) { (void)arg; demo_log_work(); return 0; }
+#else
+#include <pthread.h>
+static void *demo_log_worker( void *arg ) { (void)arg; demo_log_work(); return 0; }
+#endif
+static void demo_log_visit( int ring, const error64_record *recs, size_t n, void *user ) {
+    int *found = (int *)user;
+    (void)ring;
+    *found += n == 2 && recs[0].code == demo_log_codes[0] && recs[1].code == demo_log_codes[1];
+}
+#endif
+
+#ifdef ERROR64_TASK_LOCAL
+static int64_t demo_task_slot;
+static int64_t *demo_task_location( void ) {
+    return &demo_task_slot;
+}
+#endif
+
+// A glossary() callback, as in ERROR64_USER_DEFINED_GLOSSARY builds
+static const char *demo_glossary( int u ) {
+    return u == 1 ? "PROTOCOL" : u == 4000 ? "BITSTREAM" : "??";
+}
+
+#ifdef ERROR64_TRACE
+static ERR_NOINLINE int64_t demo_trace_open( void ) {
+    return ERROR64_RAISE(NN_FILE | ERR_MISSING);
+}
+static ERR_NOINLINE int64_t demo_trace_load( void ) {
+    volatile int64_t ec = demo_trace_open(); // not a tail call: keeps this frame on the stack
+    return ec;
+}
+#endif
+
+int main() {
+    char buf256[256];
+
+    // simplest case: errno64 showcase
+    errno64 = ERROR64(NN_SERVICE | ERR_NOT_AVAILABLE);
+    printf(">> %s\n", strerror64(buf256, errno64) );
+    printf(">> %s\n", strerror64ex(buf256, errno64) );
+
+//  test suite {
+#   define TEST(errcode, str) ( strerror64(buf256, errcode), printf("[%s] %s\n", strcmp(str,buf256) ? "FAIL" : " OK ", buf256) )
+
+    // simple attributes
+    TEST( ERROR64(ERR_NOT_ALLOWED), "NOT ALLOWED");
+    TEST( ERROR64(ERR_NOT_FOUND), "NOT FOUND" );
+    TEST( ERROR64(ERR_INVALID), "NOT VALID" );
+
+    // composited attributes
+    TEST( ERROR64(ERR_NOT | ERR_NEEDED), "NOT NEEDED");
+    TEST( ERROR64(ERR_NOT | ERR_AVAILABLE), "NOT AVAILABLE");
+
+    // app-defined nouns + attributes
+    TEST( ERROR64(NN_MEMORY | ERR_OUT_OF_RANGE), "MEMORY OUT OF RANGE");
+    TEST( ERROR64(NN_STACK | ERR_OVERFLOW), "STACK OVERFLOW");
+    TEST( ERROR64(NN_EXCEPTION | ERR_THROWN), "EXCEPTION THROWN");
+    TEST( ERROR64(NN_DISK | ERR_FULL), "DISK FULL");
+    TEST( ERROR64(NN_FILE | ERR_NOT_FOUND), "FILE NOT FOUND" );
+    TEST( ERROR64(NN_PROTOCOL | ERR_NOT_AVAILABLE), "PROTOCOL NOT AVAILABLE");
+    TEST( ERROR64(NN_CLIENT | ERR_NOT_AUTHORIZED), "CLIENT NOT AUTHORIZED");
+    TEST( ERROR64(NN_USER | ERR_NOT_REGISTERED), "USER NOT REGISTERED");
+    TEST( ERROR64(NN_REPOSITORY | ERR_NOT_CREATED), "REPOSITORY NOT CREATED");
+    TEST( ERROR64(NN_WEBSITE | ERR_NOT_RESPONDING), "WEBSITE NOT RESPONDING");
+    TEST( ERROR64(NN_WIDGET | ERR_TOO_COMPLEX), "WIDGET TOO COMPLEX");
+
+    // app-defined nouns + composed attributes
+    TEST( ERROR64(ERR_NOT | ERR_A | NN_DIRECTORY), "NOT A DIRECTORY" );
+    TEST( ERROR64(ERR_NOT | ERR_ENOUGH | NN_SPACE), "NOT ENOUGH SPACE" );
+
+    // every attribute resolves to its own table entry
+#   define ERR_TEST_ATTR(n, id, str) printf("[%s] %s\n", strcmp(str, err_attr_names[ERROR64_GET_A(ERROR64(ERR_##id))]) || err_attr_lens[n] != strlen(str) ? "FAIL" : " OK ", str); TEST( ERROR64(ERR_##id), str );
+    ERR_ATTRIBUTES(ERR_TEST_ATTR)
+#   undef ERR_TEST_ATTR
+
+    // length-aware variant returns written length and truncates safely
+    printf("[%s] strerror64_n\n", strerror64_n(buf256, 256, ERROR64(NN_DISK | ERR_FULL)) == 9 && !strcmp(buf256, "DISK FULL") ? " OK " : "FAIL");
+    printf("[%s] strerror64_n (truncated)\n", strerror64_n(buf256, 7, ERROR64(NN_DISK | ERR_FULL)) == 6 && !strcmp(buf256, "DISK F") ? " OK " : "FAIL");
+
+    // extended info
+    printf("[%s] %s\n", !strcmp(strerror64ex(buf256, ERR_ERROR | (3LL << ERR_BIT_V) | (12345LL << ERR_BIT_R) | (26LL << ERR_BIT_L) | ERR_INVALID | NN_FILE),
+        "FILE NOT VALID ; ERR_833039001AC98039 error=1,api=3,rev=12345,line=26,neg=1,attr=147,noun=57") ? " OK " : "FAIL", buf256);
+    printf("[%s] %s\n", !strcmp(strerror64ex(buf256, 0), "No error ; ERR_0000000000000000") ? " OK " : "FAIL", buf256);
+
+#ifdef ERROR64_BINLOG
+    // binary log keeps raw codes, oldest first
+    {
+        error64_record recs[4];
+        int64_t first = ERROR64_LOG(NN_DISK | ERR_FULL), second = ERROR64_LOG(NN_FILE | ERR_NOT_FOUND);
+        size_t n = error64_log_dump( recs, 4 );
+        printf("[%s] error64_log_dump\n", n == 2 && recs[0].code == first && recs[1].code == second && recs[0].timestamp <= recs[1].timestamp ? " OK " : "FAIL");
+        error64_log_decode( stdout, recs, n );
+    }
+    // every thread's ring stays reachable, even after the thread exited
+    {
+        error64_record recs[ERROR64_BINLOG_CAPACITY];
+        int found = 0, ok;
+#ifdef _WIN32
+        HANDLE th = CreateThread( 0, 0, demo_log_worker, 0, 0, 0 );
+        ok = th != 0 && WaitForSingleObject( th, INFINITE ) == WAIT_OBJECT_0;
+        if( th ) CloseHandle( th );
+#else
+        pthread_t th;
+        ok = !pthread_create( &th, 0, demo_log_worker, 0 ) && !pthread_join( th, 0 );
+#endif
+        ok &= error64_log_dump_all( recs, ERROR64_BINLOG_CAPACITY, demo_log_visit, &found ) >= 2 && found == 1;
+        printf("[%s] error64_log_dump_all (worker ring)\n", ok ? " OK " : "FAIL");
+    }
+#endif
+
+#if defined(__cplusplus) && __cplusplus >= 201703L
+    // compile-time messages
+    static_assert( error64::message<ERROR64(NN_DISK | ERR_FULL)>() == "DISK FULL", "constexpr message" );
+    static_assert( error64::message<ERROR64(ERR_NOT | ERR_A | NN_DIRECTORY)>() == "NOT A DIRECTORY", "constexpr message" );
+    static_assert( error64::message<ERROR64(ERR_NO_SUCH | NN_FILE)>() == "NO SUCH FILE", "constexpr message" );
+    static_assert( error64::message<ERROR64(ERR_INVALID)>() == "NOT VALID", "constexpr message" );
+    static_assert( error64::message<0>().empty(), "constexpr message" );
+    TEST( ERROR64(NN_SERVICE | ERR_TIMED_OUT), error64::message<ERROR64(NN_SERVICE | ERR_TIMED_OUT)>().data() );
+#endif
+
+    // registered glossaries replace the built-in nouns
+    {
+        static const char *const names[] = { "", "PROTOCOL", "BITSTREAM" };
+        static const uint8_t lens[] = { 0, 8, 9 };
+        error64_glossary_register( names, lens, 3 );
+        TEST( ERROR64(2 | ERR_INVALID), "BITSTREAM NOT VALID" );
+        TEST( ERROR64(3 | ERR_INVALID), "?? NOT VALID" );
+        error64_glossary_register( names, 0, 3 );
+        TEST( ERROR64(1 | ERR_NOT_SUPPORTED), "PROTOCOL NOT SUPPORTED" );
+        error64_glossary_register( 0, 0, 0 );
+        TEST( ERROR64(NN_DISK | ERR_FULL), "DISK FULL" );
+        // per-api glossaries only affect codes raised with that api number
+        error64_glossary_register_api( 5, names, lens, 3 );
+        TEST( ERROR64(2 | ERR_INVALID) | (5LL << ERR_BIT_V), "BITSTREAM NOT VALID" );
+        TEST( ERROR64(2 | ERR_INVALID) | (6LL << ERR_BIT_V), "ACCOUNT NOT VALID" );
+        error64_glossary_register_api( 5, 0, 0, 0 );
+        TEST( ERROR64(2 | ERR_INVALID) | (5LL << ERR_BIT_V), "ACCOUNT NOT VALID" );
+        // out-of-range apis are rejected, not wrapped onto another api's slot
+        printf("[%s] error64_glossary_register_api (api out of range)\n", error64_glossary_register_api( 133, names, lens, 3 ) == -1 &&
+            error64_glossary_register_fn( -2, 0 ) == -1 && error64_glossary_register_api( 127, 0, 0, 0 ) == 0 ? " OK " : "FAIL");
+        TEST( ERROR64(2 | ERR_INVALID) | (5LL << ERR_BIT_V), "ACCOUNT NOT VALID" );
+#ifndef ERROR64_USER_DEFINED_GLOSSARY
+        error64_glossary_register( err_noun_names, err_noun_lens, (int)(sizeof(err_noun_names) / sizeof(err_noun_names[0])) );
+#endif
+    }
+
+#ifdef ERROR64_CACHE
+    // cached messages: one miss, then hits
+    {
+        uint64_t hits0, misses0, hits, misses;
+        size_t len;
+        int64_t ec = ERROR64(NN_NETWORK | ERR_TIMED_OUT);
+        error64_cache_stats( &hits0, &misses0 );
+        strerror64_cached( ec, 0 );
+        printf("[%s] %s\n", !strcmp(strerror64_cached( ec, &len ), "NETWORK TIMED OUT") && len == 17 ? " OK " : "FAIL", strerror64_cached( ec, 0 ));
+        error64_cache_stats( &hits, &misses );
+#ifndef ERROR64_PRECOMPUTED_TABLE
+        printf("[%s] error64_cache_stats\n", hits - hits0 == 2 && misses - misses0 == 1 ? " OK " : "FAIL");
+#endif
+    }
+#endif
+
+    // zero-copy fragments, already ordered
+    {
+        struct error64_parts parts;
+        int n = error64_parts( ERROR64(ERR_NOT | ERR_ENOUGH | NN_SPACE), &parts );
+        printf("[%s] error64_parts\n", n == 3 && parts.count == 3 &&
+            parts.frag[0].len == 3 && !memcmp(parts.frag[0].ptr, "NOT", 3) &&
+            parts.frag[1].len == 6 && !memcmp(parts.frag[1].ptr, "ENOUGH", 6) &&
+            parts.frag[2].len == 5 && !memcmp(parts.frag[2].ptr, "SPACE", 5) && !error64_parts( 1, &parts ) ? " OK " : "FAIL");
+    }
+
+    // batch decoding matches ERROR64_GET_*() and strerror64()
+    {
+        int64_t codes[19];
+        uint8_t e[19], v[19], n[19], a[19];
+        uint16_t r[19], l[19], u[19];
+        uint32_t offsets[20];
+        static char arena[19 * 256];
+        struct error64_fields soa = { e, v, r, l, n, a, u };
+        int i, ok = 1;
+        for( i = 0; i < 19; ++i ) {
+            codes[i] = ERROR64( (i * 7) | ERR_NOT_FULL ) ^ (int64_t)((i * 0x9e3779b97f4a7c15ull) & ~0xffffffull);
+        }
+        error64_decode_batch( codes, 19, &soa );
+        ok &= strerror64_batch( codes, 19, arena, sizeof(arena), offsets ) == 19;
+        for( i = 0; i < 19; ++i ) {
+            ok &= e[i] == ERROR64_GET_E(codes[i]) && v[i] == ERROR64_GET_V(codes[i]) && r[i] == ERROR64_GET_R(codes[i]);
+            ok &= l[i] == ERROR64_GET_L(codes[i]) && n[i] == ERROR64_GET_N(codes[i]) && a[i] == ERROR64_GET_A(codes[i]);
+            ok &= u[i] == ERROR64_GET_U(codes[i]) && !strcmp( arena + offsets[i], strerror64(buf256, codes[i]) );
+            ok &= offsets[i + 1] - offsets[i] - 1 == strlen(buf256);
+        }
+        ok &= strerror64_batch( codes, 19, arena, 256, offsets ) == 1 && !strerror64_batch( codes, 19, arena, 255, offsets );
+        printf("[%s] error64_decode_batch, strerror64_batch\n", ok ? " OK " : "FAIL");
+    }
+
+#ifdef ERROR64_STATS
+    // raise statistics, per site and per descriptor
+    {
+        error64_stat sites[64], descs[64];
+        size_t num_sites = 64, num_descs = 64, i;
+        uint64_t site_hits = 0, desc_hits = 0, desc_before = 0;
+        int64_t site = 0;
+        // DISK FULL may have been raised already (ERROR64_LOG goes through the raise hooks too)
+        error64_stats_snapshot( sites, &num_sites, descs, &num_descs );
+        for( i = 0; i < num_descs; ++i ) {
+            if( !strcmp( strerror64(buf256, descs[i].key), "DISK FULL" ) ) desc_before = descs[i].count;
+        }
+        num_sites = 64, num_descs = 64;
+        for( i = 0; i < 3; ++i ) {
+            site = ERROR64_RAISE(NN_DISK | ERR_FULL);
+        }
+        error64_stats_snapshot( sites, &num_sites, descs, &num_descs );
+        for( i = 0; i < num_sites; ++i ) {
+            if( ERROR64_GET_L(sites[i].key) == ERROR64_GET_L(site) ) site_hits = sites[i].count;
+        }
+        for( i = 0; i < num_descs; ++i ) {
+            if( !strcmp( strerror64(buf256, descs[i].key), "DISK FULL" ) ) desc_hits = descs[i].count;
+        }
+        printf("[%s] error64_stats_snapshot\n", site_hits == 3 && desc_hits - desc_before == 3 ? " OK " : "FAIL");
+    }
+#endif
+
+#ifdef ERROR64_TASK_LOCAL
+    // task-local errno64 follows the installed location hook
+    {
+        errno64 = 0;
+        error64_set_location_hook( demo_task_location );
+        ERROR64_RAISE(NN_REQUEST | ERR_NOT_FOUND);
+        error64_set_location_hook( 0 );
+        printf("[%s] error64_set_location_hook\n", errno64 == 0 && !strcmp( strerror64(buf256, demo_task_slot), "REQUEST NOT FOUND" ) ? " OK " : "FAIL");
+    }
+#endif
+
+#ifdef ERROR64_CHAIN
+    // cause chain: each raise records the error it replaces
+    {
+        const error64_frame *frames;
+        int64_t disk, file;
+        size_t n;
+        errno64 = 0;
+        error64_chain_reset();
+        disk = ERROR64_RAISE(NN_DISK | ERR_FULL);
+        file = ERROR64_RAISE(NN_FILE | ERR_NOT_WRITABLE);
+        ERROR64_RAISE(NN_SERVICE | ERR_FAILED);
+        n = error64_chain( &frames );
+        printf("[%s] error64_chain\n", n == 2 && frames[0].code == disk && frames[1].code == file ? " OK " : "FAIL");
+        error64_chain_print( stdout, errno64 );
+        error64_chain_reset();
+        errno64 = 0;
+    }
+#endif
+
+    // explicit contexts do not touch errno64
+    {
+        error64_ctx ctx = { 0 };
+        int64_t before = errno64 = 0;
+        ERROR64_CTX_RAISE( &ctx, NN_PEER | ERR_NOT_RESPONDING );
+        TEST( ctx.code, "PEER NOT RESPONDING" );
+        printf("[%s] error64_ctx\n", errno64 == before ? " OK " : "FAIL");
+    }
+
+#ifdef ERROR64_SITES
+    // site registry: every raise site above has a record
+    {
+        const error64_site *sites, *s;
+        size_t n = error64_site_list( &sites ), i;
+        int64_t ec = ERROR64_SITE(NN_STRING | ERR_INVALID); int line = __LINE__;
+        volatile int64_t noun = NN_DISK;
+        int64_t dynamic = ERROR64_SITE(noun | ERR_FULL); int dynamic_line = __LINE__, found = 0;
+        int ok = n > 0 && ERROR64_GET_U(dynamic) == NN_DISK && !error64_site_find( dynamic );
+        for( i = 1; i < n; ++i ) ok &= (uint64_t)sites[i-1].code - 1 <= (uint64_t)sites[i].code - 1;
+        for( i = 0; i < n; ++i ) found |= !sites[i].code && sites[i].line == (uint32_t)dynamic_line;
+        ok &= found;
+        s = error64_site_find( ec );
+        ok &= s && s->line == (uint32_t)line && !strcmp( s->file, __FILE__ ) && !strcmp( s->func, "main" );
+        ok &= !error64_site_find( ERROR64(NN_STRING | ERR_INVALID) ) && !error64_site_find( 0 );
+        printf("[%s] error64_site_list (%d records)\n", ok ? " OK " : "FAIL", (int)n);
+    }
+#endif
+
+    // text parser: every built-in message parses back into a code that renders the same
+    {
+        char buf256[256], again[256];
+        int u, n, a, nouns = (int)(sizeof(err_noun_names) / sizeof(err_noun_names[0])), same = 0, total = 0, exact = 0;
+        int64_t ec = ERROR64(NN_FILE | ERR_NOT | ERR_READABLE), back;
+        for( u = 0; u < nouns; ++u ) for( n = 0; n < 2; ++n ) for( a = 0; a < 256; ++a ) {
+            if( a && !err_attr_lens[a] ) continue;
+            ec = ERR_ERROR | ((int64_t)n << ERR_BIT_N) | ((int64_t)a << ERR_BIT_A) | u;
+            strerror64_n( buf256, 256, ec );
+            back = strtoerror64( buf256, strlen(buf256) );
+            strerror64_n( again, 256, back );
+            total += !!buf256[0], same += !!buf256[0] && !strcmp( buf256, again ), exact += back == ec;
+        }
+        printf("[%s] strtoerror64 short form (%d/%d messages, %d exact codes)\n", same == total ? " OK " : "FAIL", same, total, exact);
+        ec = ERROR64(NN_FILE | ERR_NOT | ERR_READABLE);
+        strerror64ex( buf256, ec ); strcat( buf256, "\n" );
+        n = strtoerror64( buf256, strlen(buf256) ) == ec;
+        n &= strtoerror64( "FILE NOT READABLE ; ERR_0x8000000012345678 error=1", 50 ) == (int64_t)0x8000000012345678ull;
+        n &= strtoerror64( "No error ; ERR_0000000000000000", 31 ) == 0 && strtoerror64( "FILE BOGUS", 10 ) == 0;
+        n &= strtoerror64( "", 0 ) == 0 && strtoerror64( "NOT", 3 ) == (ERR_ERROR | ERR_NOT) && strtoerror64( "BOGUS FULL", 10 ) == 0;
+        n &= strtoerror64( "NO SUCH FILE", 12 ) == (ERR_ERROR | ERR_NO_SUCH | NN_FILE) && strtoerror64( "DISK FULL", 9 ) == (ERR_ERROR | ERR_FULL | NN_DISK);
+        printf("[%s] strtoerror64 extended form\n", n ? " OK " : "FAIL");
+    }
+
+    // text parser: nouns come from the glossary short messages print with, callbacks and api 0 tables included
+    {
+        static const char *const names[] = { "", "WIDGETRY" };
+        int n;
+        error64_glossary_register_fn( -1, demo_glossary );
+        n = strtoerror64( "PROTOCOL NOT SUPPORTED", 22 ) == (ERR_ERROR | ERR_NOT_SUPPORTED | 1);
+        n &= strtoerror64( "NO SUCH BITSTREAM", 17 ) == (ERR_ERROR | ERR_NO_SUCH | 4000) && strtoerror64( "DISK FULL", 9 ) == 0;
+        n &= strtoerror64( "?? FULL", 7 ) == 0;
+        error64_glossary_register_api( 0, names, 0, 2 );
+        n &= strtoerror64( "WIDGETRY FULL", 13 ) == (ERR_ERROR | ERR_FULL | 1) && strtoerror64( "PROTOCOL FULL", 13 ) == 0;
+        error64_glossary_register_api( 0, 0, 0, 0 );
+        error64_glossary_register_fn( -1, 0 );
+#ifndef ERROR64_USER_DEFINED_GLOSSARY
+        error64_glossary_register( err_noun_names, err_noun_lens, (int)(sizeof(err_noun_names) / sizeof(err_noun_names[0])) );
+#endif
+        n &= strtoerror64( "DISK FULL", 9 ) == (ERR_ERROR | ERR_FULL | NN_DISK);
+        printf("[%s] strtoerror64 with callback and per-api glossaries\n", n ? " OK " : "FAIL");
+    }
+
+    // wire format: lossless round trip, api/rev sent once per run
+    {
+        int64_t codes[64], back[64];
+        uint8_t wire[64 * ERROR64_WIRE_MAX];
+        size_t len, len2, i, n;
+        unsigned seed = 7;
+        int ok;
+        for( i = 0; i < 64; ++i ) {
+            seed = seed * 1103515245u + 12345u;
+            codes[i] = ERR_ERROR | ((int64_t)((seed >> 4) % 2000) << ERR_BIT_L) | ((seed >> 16) & 1 ? ERR_NOT : 0) |
+                ((int64_t)((seed >> 8) % 152) << ERR_BIT_A) | (seed % 200);
+        }
+        codes[10] = 0; codes[11] = 12345; codes[12] = -1; codes[13] = INT64_MAX; codes[14] = INT64_MIN;
+        n = error64_encode( codes, 64, wire, sizeof(wire), &len );
+        ok = n == 64 && error64_decode( wire, len, back, 64 ) == 64 && !memcmp( codes, back, sizeof(codes) );
+        ok &= error64_decode( wire, len - 1, back, 64 ) == 63;
+        wire[0] |= 1, ok &= error64_decode( wire, len, back, 64 ) == 0;
+        ok &= error64_encode( codes, 64, wire, ERROR64_WIRE_MAX + 1, &len2 ) == 1;
+        printf("[%s] error64_encode/decode (%d bytes for %d codes)\n", ok ? " OK " : "FAIL", (int)len, (int)n);
+    }
+
+#if defined(__cplusplus) && __cplusplus >= 201703L
+    // result<T>: packed into one int64_t for small values and pointers
+    {
+        struct demo {
+            static error64::result<int32_t> parse( const char *s ) {
+                if( !s || !*s ) return ERROR64_FAIL(NN_STRING | ERR_EMPTY);
+                return atoi( s );
+            }
+            static error64::result<void> check( int v ) {
+                if( v < 0 ) return error64::fail( ERROR64(NN_VALUE | ERR_OUT_OF_RANGE) );
+                return {};
+            }
+        };
+        static_assert( sizeof(error64::result<int32_t>) == 8 && sizeof(error64::result<const char *>) == 8, "packed result" );
+        static_assert( std::is_trivially_move_constructible_v<error64::result<int32_t>> && std::is_trivially_destructible_v<error64::result<int32_t>>, "register-passable result" );
+        static_assert( !std::is_copy_constructible_v<error64::result<int32_t>> && !std::is_copy_constructible_v<error64::result<std::string_view>>, "move-only result" );
+        error64::result<int32_t> a = demo::parse( "-42" ), b = demo::parse( "" );
+        error64::result<std::string_view> m = std::string_view( "ok" ), f = error64::fail( NN_STRING | ERR_EMPTY );
+        error64::result<const char *> p = "ptr";
+        int errno_untouched = ( errno64 = 0, (void)demo::parse( 0 ), errno64 == 0 );
+        int ok = a && *a == -42 && !a.error() && !b && ERROR64_GET_A(b.error()) == ERROR64_GET_A(ERR_EMPTY) && b.value_or( 7 ) == 7;
+        ok &= m && m->size() == 2 && !f && f.error() == (ERR_ERROR | NN_STRING | ERR_EMPTY) && *p == std::string_view("ptr");
+        ok &= demo::check( 1 ).ok() && demo::check( -1 ).error() < 0 && errno_untouched;
+        error64::result<std::string_view> moved = std::move( m );
+        ok &= moved.value() == "ok";
+        printf("[%s] error64::result\n", ok ? " OK " : "FAIL");
+    }
+#endif
+
+#if defined(__cplusplus) && __cplusplus >= 201703L
+    // std::error_code: descriptor as value, api as category, locator recovered from the locator table
+    {
+        int64_t ec = ERROR64(NN_NETWORK | ERR_NOT | ERR_RESPONDING);
+        std::error_code e = error64::make_error_code( ec ), lib = error64::make_error_code( ERR_ERROR | (5LL << ERR_BIT_V) | ERR_FULL );
+        int ok = e && e.category() == error64_category() && e.message() == "NETWORK NOT RESPONDING" && error64::to_error64( e ) == ec;
+        ok &= lib.category() == error64_category( 5 ) && lib.category() != e.category() && lib.message() == "FULL";
+        ok &= error64::to_error64( std::error_code( e.value(), error64_category() ) ) == ec && !error64::make_error_code( 0 );
+        ok &= error64::to_error64( std::make_error_code( std::errc::invalid_argument ) ) == 0 && !strcmp( e.category().name(), "error64" );
+        ok &= error64::make_error_code( ERROR64(ERR_FULL) ).value() != 0;
+        // handed off to another thread, as completion handlers are: rev/line survive
+        {
+            int64_t seen = 0;
+            std::thread( [&] { seen = error64::to_error64( e ); } ).join();
+            ok &= seen == ec;
+        }
+        printf("[%s] error64_category: %s\n", ok ? " OK " : "FAIL", e.message().c_str());
+    }
+#endif
+
+#ifdef ERROR64_CATALOG
+    // external catalog: build, map, hot reload, close
+    {
+        static const char *nouns[NN_FILE + 1], *attrs[256], *nouns2[NN_FILE + 1];
+        static char blob[4096];
+        const char *path = "error64_demo.cat";
+        int64_t ec = ERROR64(NN_FILE | ERR_MISSING);
+        size_t n;
+        FILE *fp;
+        int ok;
+        nouns[NN_FILE] = "FICHERO", attrs[ERROR64_GET_A(ERR_MISSING)] = "AUSENTE", nouns2[NN_FILE] = "DATEI";
+        n = error64_catalog_build( nouns, NN_FILE + 1, attrs, 256, blob, sizeof(blob) );
+        ok = n <= sizeof(blob) && (fp = fopen( path, "wb" )) && fwrite( blob, 1, n, fp ) == n && !fclose( fp );
+        ok &= !error64_catalog_swap( error64_catalog_open( path ) );
+        ok &= !strcmp( strerror64( buf256, ec ), "FICHERO AUSENTE" ) && !strcmp( strerror64( buf256, ERROR64(NN_SERVICE | ERR_MISSING) ), "?? AUSENTE" );
+        n = error64_catalog_build( nouns2, NN_FILE + 1, 0, 0, blob, sizeof(blob) );
+        ok &= (fp = fopen( path, "wb" )) && fwrite( blob, 1, n, fp ) == n && !fclose( fp );
+        error64_catalog_close( error64_catalog_swap( error64_catalog_open( path ) ) );
+        ok &= !strcmp( strerror64( buf256, ec ), "DATEI MISSING" );
+        ok &= (fp = fopen( path, "wb" )) && fwrite( blob, 1, n - 1, fp ) == n - 1 && !fclose( fp );
+        ok &= !error64_catalog_open( path ) && !error64_catalog_open( "missing.cat" );
+        remove( path );
+        error64_catalog_close( error64_catalog_swap( 0 ) );
+        ok &= !strcmp( strerror64( buf256, ec ), "FILE MISSING" );
+        printf("[%s] error64_catalog\n", ok ? " OK " : "FAIL");
+    }
+#endif
+
+    // localized messages: per-call tables and word order
+    {
+        static error64_fragment es_nouns[NN_FILE + 1], es_attrs[256], ja_attrs[256], ja_negated[256];
+        static uint8_t ja_special[512];
+        error64_locale es, ja;
+        int ok;
+        memset( &es, 0, sizeof(es) ), memset( &ja, 0, sizeof(ja) );
+        static const error64_fragment archivo = ERROR64_FRAGMENT("ARCHIVO");
+        es_nouns[NN_FILE] = archivo;
+        es_attrs[ERROR64_GET_A(ERR_FOUND)].ptr = "ENCONTRADO", es_attrs[ERROR64_GET_A(ERR_FOUND)].len = 10;
+        es.nouns = es_nouns, es.num_nouns = NN_FILE + 1, es.attrs = es_attrs;
+        es.negation.ptr = "NO", es.negation.len = 2;
+        es.order[0] = 0, es.order[1] = 1, es.order[2] = 2;
+        ja_attrs[ERROR64_GET_A(ERR_FOUND)].ptr = "MITSUKARIMASHITA", ja_attrs[ERROR64_GET_A(ERR_FOUND)].len = 16;
+        ja_negated[ERROR64_GET_A(ERR_FOUND)].ptr = "MITSUKARIMASEN", ja_negated[ERROR64_GET_A(ERR_FOUND)].len = 14;
+        ja_special[ERROR64_GET_A(ERR_FULL)] = 1;
+        ja.attrs = ja_attrs, ja.negated = ja_negated, ja.special = ja_special, ja.separator = "-";
+        ja.order[0] = 0, ja.order[1] = 1, ja.order[2] = 2;
+        ja.special_order[0] = 2, ja.special_order[1] = 1, ja.special_order[2] = 0;
+        ok = !strcmp( strerror64_l( buf256, ERROR64(NN_FILE | ERR_NOT | ERR_FOUND), &es ), "ARCHIVO NO ENCONTRADO" );
+        ok &= !strcmp( strerror64_l( buf256, ERROR64(NN_DISK | ERR_FULL), &es ), "DISK FULL" );
+        ok &= !strcmp( strerror64_l( buf256, ERROR64(NN_SERVICE | ERR_FULL), &es ), "?? FULL" );
+        ok &= !strcmp( strerror64_l( buf256, ERROR64(NN_FILE | ERR_NOT | ERR_FOUND), &ja ), "FILE-MITSUKARIMASEN" );
+        ok &= !strcmp( strerror64_l( buf256, ERROR64(NN_FILE | ERR_FOUND), &ja ), "FILE-MITSUKARIMASHITA" );
+        ok &= !strcmp( strerror64_l( buf256, ERROR64(NN_DISK | ERR_FULL), &ja ), "FULL-DISK" );
+        ok &= !strcmp( strerror64_l( buf256, ERROR64(ERR_NO_SUCH | NN_FILE), 0 ), "NO SUCH FILE" );
+        ok &= strerror64_l_n( buf256, 8, ERROR64(NN_FILE | ERR_NOT | ERR_FOUND), &es ) == 7 && !strcmp( buf256, "ARCHIVO" );
+        printf("[%s] strerror64_l: %s\n", ok ? " OK " : "FAIL", strerror64_l( buf256, ERROR64(NN_FILE | ERR_NOT | ERR_FOUND), &es ));
+    }
+
+    // structured emitters: JSON, logfmt and the streaming writer
+    {
+        static const char *quoted[] = { "", "SAY \"HI\"\\\n" };
+        int64_t ec = ERR_ERROR | (3LL << ERR_BIT_V) | (7LL << ERR_BIT_R) | (1413LL << ERR_BIT_L) | NN_SERVICE | ERR_FAILED;
+        error64_writer w;
+        size_t n = error64_to_json( buf256, 256, ec );
+        int ok = n == strlen(buf256) && !strcmp( buf256, "{\"code\":\"8300070585158098\",\"error\":1,\"api\":3,\"rev\":7,\"line\":1413,"
+            "\"neg\":0,\"attr\":43,\"noun\":152,\"message\":\"SERVICE FAILED\"}" );
+        ok &= error64_to_json( buf256, n, ec ) == 0 && !buf256[0] && error64_to_json( buf256, n + 1, ec ) == n;
+        ok &= error64_to_logfmt( buf256, 256, ec ) == strlen(buf256) &&
+            !strcmp( buf256, "code=8300070585158098 error=1 api=3 rev=7 line=1413 neg=0 attr=43 noun=152 msg=\"SERVICE FAILED\"" );
+        ok &= error64_to_logfmt( buf256, 256, 0 ) && !strcmp( buf256, "code=0000000000000000 error=0 api=0 rev=0 line=0 neg=0 attr=0 noun=0 msg=\"\"" );
+        error64_glossary_register_api( 9, quoted, 0, 2 );
+        ok &= error64_to_json( buf256, 256, ERR_ERROR | (9LL << ERR_BIT_V) | 1 ) && !!strstr( buf256, "\"message\":\"SAY \\\"HI\\\"\\\\\\u000a\"}" );
+        error64_glossary_register_api( 9, 0, 0, 0 );
+        error64_writer_init( &w, ERROR64_JSON, 0 );
+        for( n = 0; n < 1000; ++n ) ok &= error64_writer_append( &w, ec );
+        ok &= w.len == 1000 * (error64_to_json( buf256, 256, ec ) + 1) && w.data[w.len - 1] == '\n' && !w.data[w.len];
+        error64_writer_free( &w );
+        printf("[%s] error64_to_json/logfmt\n", ok ? " OK " : "FAIL");
+    }
+
+#ifdef ERROR64_SAMPLER
+    // sampler: a burst per window, then "N suppressed" summaries
+    {
+        int64_t ec = ERROR64(NN_NETWORK | ERR_TIMED_OUT);
+        int64_t other = ERROR64(NN_NETWORK | ERR_TIMED_OUT); // same descriptor, another line: another key
+        error64_sample summary[4];
+        int i, reported = 0, reported_other = 0, ok;
+        size_t n;
+        for( i = 0; i < 1000; ++i ) reported += error64_should_report_at( ec, 5000 ), reported_other += error64_should_report_at( other, 5999 );
+        ok = reported == ERROR64_SAMPLER_BURST && reported_other == ERROR64_SAMPLER_BURST && error64_sampler_flush_at( summary, 4, 5999 ) == 0;
+        // ec rolls its window over by raising again; other goes quiet and is closed by the flush
+        ok &= error64_should_report_at( ec, 6000 );
+        n = error64_sampler_flush_at( summary, 4, 6000 );
+        ok &= n == 2 && summary[0].suppressed == 1000 - ERROR64_SAMPLER_BURST && summary[1].suppressed == 1000 - ERROR64_SAMPLER_BURST;
+        ok &= (summary[0].code == (ec & ~(0xffffLL << ERR_BIT_R))) + (summary[1].code == (other & ~(0xffffLL << ERR_BIT_R))) == 2 ||
+              (summary[1].code == (ec & ~(0xffffLL << ERR_BIT_R))) + (summary[0].code == (other & ~(0xffffLL << ERR_BIT_R))) == 2;
+        ok &= error64_sampler_flush_at( summary, 4, 9000 ) == 0;
+        ok &= error64_should_report( ERROR64(NN_NETWORK | ERR_FULL) ) && error64_sampler_flush( summary, 4 ) == 0;
+        printf("[%s] error64_should_report (%d of 1000 reported)\n", ok ? " OK " : "FAIL", reported);
+    }
+#endif
+
+#ifdef ERROR64_SHM
+    // shared-memory board: a second mapping of the segment stands in for another process
+    {
+        error64_board *board = error64_board_open( "/error64_demo" ), *other = error64_board_open( "/error64_demo" );
+        int ok = board && other && board != other, i;
+        if( ok ) {
+            int64_t recent[4];
+            for( i = 0; i < 3; ++i ) ERROR64_RAISE(NN_DISK | ERR_FULL);
+            ok = error64_board_count( other, ERROR64(NN_DISK | ERR_FULL) ) == 3 && error64_board_count( other, ERROR64(NN_DISK | ERR_EMPTY) ) == 0;
+            ok &= error64_board_recent( other, recent, 4 ) == 3 && ERROR64_GET_L(recent[0]) == ERROR64_GET_L(errno64);
+            ok &= error64_board_dump( stdout, other ) == 4;
+            error64_board_close( other );
+        }
+        error64_board_close( board );
+        error64_board_unlink( "/error64_demo" );
+        errno64 = 0;
+        printf("[%s] error64_board_open, shared counters and recent ring\n", ok ? " OK " : "FAIL");
+    }
+#endif
+
+#ifdef ERROR64_ASYNC
+    // async formatting: codes go through the queue, lines come out of the formatter thread in batches
+    {
+#ifdef _WIN32
+        int fd = _open( "async.log", _O_WRONLY | _O_CREAT | _O_TRUNC, 0644 );
+#else
+        int fd = open( "async.log", O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+#endif
+        error64_async_stats st;
+        char line[512];
+        int i, lines = 0, queued = 0, summaries = 0, ok = fd >= 0 && error64_async_start( fd, ERROR64_ASYNC_DROP ) == 0;
+        FILE *fp;
+        ok &= error64_async_start( fd, ERROR64_ASYNC_DROP ) == -1;
+        for( i = 0; i < 1000; ++i ) ok &= error64_async_push( ERROR64(NN_DISK | ERR_FULL) );
+        error64_async_stop();
+        error64_async_metrics( &st );
+        ok &= st.pushed == 1000 && st.written == 1000 && st.dropped == 0 && st.depth == 0 && st.batches >= 1000 / ERROR64_ASYNC_BATCH;
+        ok &= !error64_async_push( ERROR64(NN_DISK | ERR_FULL) );
+        // 20000 codes into 4096 cells: whatever the formatter cannot keep up with is dropped and reported
+        ok &= error64_async_start( fd, ERROR64_ASYNC_COUNT ) == 0;
+        for( i = 0; i < 20000; ++i ) queued += error64_async_push( ERROR64(NN_NETWORK | ERR_TIMED_OUT) );
+        error64_async_stop();
+        error64_async_metrics( &st );
+        ok &= st.pushed == (uint64_t)queued && st.written == st.pushed && st.pushed + st.dropped == 20000;
+#ifdef _WIN32
+        _close( fd );
+#else
+        close( fd );
+#endif
+        if( (fp = fopen( "async.log", "rb" )) != 0 ) {
+            while( fgets( line, sizeof(line), fp ) ) {
+                lines += strstr( line, " T1 DISK FULL ; ERR_" ) || strstr( line, " T1 NETWORK TIMED OUT ; ERR_" );
+                summaries += strstr( line, " codes dropped" ) != 0;
+            }
+            fclose( fp );
+        }
+        ok &= lines == 1000 + queued && (summaries > 0) == (st.dropped > 0);
+        remove( "async.log" );
+        printf("[%s] error64_async_push (%d of 20000 queued, %u batches, max depth %u)\n", ok ? " OK " : "FAIL", queued, (unsigned)st.batches, (unsigned)st.max_depth);
+    }
+#endif
+
+#ifdef ERROR64_TRACE
+    // raise traces: raw return addresses on raise, symbols on print
+    {
+        void *frames[ERROR64_TRACE_DEPTH];
+        int64_t ec = demo_trace_load();
+        size_t n = error64_trace( ec, frames, ERROR64_TRACE_DEPTH );
+        // innermost frames return into demo_trace_open(), then demo_trace_load(): compare with the closest entry point.
+        // Unwinders without frame pointers or unwind tables may stop early, so only the frames found are checked
+        uintptr_t open = (uintptr_t)demo_trace_open, load = (uintptr_t)demo_trace_load, at0 = n ? (uintptr_t)frames[0] : 0;
+        int ok = n < 1 || (at0 > open && (at0 < load) == (open < load));
+        ok &= n < 2 || (uintptr_t)frames[1] > load;
+        ok &= error64_trace( ERROR64(NN_FILE | ERR_MISSING), frames, 4 ) == 0 && error64_trace_print( stdout, ec ) == n;
+        errno64 = 0;
+        printf("[%s] error64_trace (%u frames)\n", ok ? " OK " : "FAIL", (unsigned)n);
+    }
+#endif
+
+    // 128-bit codes: file id + full line
+    {
+        char buf256[256];
+        error128_t a = ERROR128(NN_FILE | ERR_MISSING); uint32_t la = __LINE__;
+        error128_t b = ERROR128(NN_FILE | ERR_MISSING);
+        int ok = ERROR128_GET_FILE(a) == error64_file_id(__FILE__) && ERROR128_GET_LINE(a) == la && ERROR128_GET_LINE(b) == la + 1;
+        ok &= ERROR64_GET_A(a.code) == ERROR64_GET_A(ERR_MISSING) && ERROR128_GET_FILE(a) != error64_file_id("other.c");
+        ok &= strerror128ex_n( buf256, 256, a ) == strlen( buf256 ) && strstr( buf256, "FILE MISSING ; ERR_" ) == buf256 && !!strstr( buf256, " ; SITE_" );
+        ok &= strerror128ex_n( buf256, 8, a ) == 7 && !strcmp( buf256, "FILE MI" );
+        printf("[%s] %s\n", ok ? " OK " : "FAIL", strerror128ex( buf256, a ));
+#if defined(__cplusplus) && __cplusplus >= 201103L
+        static_assert( error64_file_id("") == 2166136261u && error64_file_id("a") == 0xe40c292cu, "FNV-1a" );
+#endif
+    }
 
     // non-errors (positive numbers) must not resolve
     TEST( 0, "" );
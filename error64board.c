@@ -0,0 +1,24 @@
+// Print the shared-memory error board of a host: raise counters of every process, then the most recent codes.
+// Usage: error64board [name] (default: "/error64", or "Local\error64" on Windows)
+// - rlyeh, public domain.
+
+#define ERROR64_SHM
+#define ERROR64_DEFINE_IMPLEMENTATION
+#define ERRNO64_DEFINE_IMPLEMENTATION
+#include "error64.h"
+
+int main( int argc, char **argv ) {
+#ifdef _WIN32
+    const char *name = argc > 1 ? argv[1] : "Local\\error64";
+#else
+    const char *name = argc > 1 ? argv[1] : "/error64";
+#endif
+    error64_board *board = error64_board_open( name );
+    if( !board ) {
+        fprintf( stderr, "error64board: cannot map %s\n", name );
+        return 1;
+    }
+    if( !error64_board_dump( stdout, board ) ) puts( "(no errors raised)" );
+    error64_board_close( board );
+    return 0;
+}
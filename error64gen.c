@@ -0,0 +1,47 @@
+// Generate error64_table.h: every built-in (noun, negate, attribute) message, for ERROR64_PRECOMPUTED_TABLE builds.
+// Usage: error64gen > error64_table.h
+// - rlyeh, public domain.
+
+#define ERROR64_DEFINE_IMPLEMENTATION
+#define ERRNO64_DEFINE_IMPLEMENTATION
+#include "error64.h"
+
+int main() {
+    int nouns = ERR_SHAPE_NOUNS, attrs = ERR_SHAPE_ATTRS;
+    int u, n, a, i, col = 0;
+    uint32_t offset = 0;
+    char buf256[256];
+
+    puts("// Generated by error64gen.c from error64.h. Do not edit.");
+    printf("#define ERROR64_TABLE_NOUNS %d\n", nouns);
+    printf("#define ERROR64_TABLE_ATTRS %d\n", attrs);
+    printf("#define ERROR64_TABLE_CHECKSUM %ldL\n", (long)ERR_SHAPE_CHECKSUM);
+
+    // string pool: '\0'-terminated messages, indexed by ( noun * 2 + negate ) * ERROR64_TABLE_ATTRS + attribute.
+    // emitted as a brace list: MSVC rejects string literals over 64 KiB, even when concatenated (C2026).
+    puts("static const char error64_table_pool[] = {");
+    for( u = 0; u < nouns; ++u ) {
+        for( n = 0; n < 2; ++n ) {
+            for( a = 0; a < attrs; ++a ) {
+                strerror64_n( buf256, 256, ERR_ERROR | ((int64_t)n << ERR_BIT_N) | ((int64_t)a << ERR_BIT_A) | u );
+                for( i = 0; i == 0 || buf256[i-1]; ++i ) {
+                    printf("%d,%s", buf256[i], ++col % 32 ? "" : "\n");
+                }
+            }
+        }
+    }
+    puts("\n};");
+
+    // offsets: one extra trailing entry, so that length = offsets[i+1] - offsets[i] - 1
+    puts("static const uint32_t error64_table_offsets[] = {");
+    for( col = 0, u = 0; u < nouns; ++u ) {
+        for( n = 0; n < 2; ++n ) {
+            for( a = 0; a < attrs; ++a ) {
+                printf("%u,%s", offset, ++col % 16 ? "" : "\n");
+                offset += (uint32_t)strerror64_n( buf256, 256, ERR_ERROR | ((int64_t)n << ERR_BIT_N) | ((int64_t)a << ERR_BIT_A) | u ) + 1;
+            }
+        }
+    }
+    printf("%u\n};\n", offset);
+    return 0;
+}
@@ -0,0 +1,23 @@
+// Decode ERROR64_BINLOG dumps (see error64_log_save()) back into text.
+// Build it against the same glossary (and ERROR64_USER_DEFINED_GLOSSARY setting) as the logging application.
+// - rlyeh, public domain.
+
+#define ERROR64_BINLOG
+#define ERROR64_DEFINE_IMPLEMENTATION
+#define ERRNO64_DEFINE_IMPLEMENTATION
+#include "error64.h"
+
+int main( int argc, char **argv ) {
+    error64_record recs[256];
+    size_t n;
+    FILE *fp = argc > 1 ? fopen( argv[1], "rb" ) : stdin;
+    if( !fp ) {
+        fprintf( stderr, "usage: %s [file.bin]\n", argv[0] );
+        return 1;
+    }
+    while( (n = fread( recs, sizeof(error64_record), 256, fp )) > 0 ) {
+        error64_log_decode( stdout, recs, n );
+    }
+    if( fp != stdin ) fclose( fp );
+    return 0;
+}